@@ -18,10 +18,91 @@
 
 #include "EventProcessor.h"
 
+#include <cstring>
+#include <new>
+
+namespace
+{
+    // memory of deleted events by 16 byte size class, bounded so a burst of events is not kept forever
+    struct EventFreeLists
+    {
+        enum
+        {
+            GRANULARITY = 16,
+            SIZE_CLASSES = 16,
+            MAX_FREE_BLOCKS = 256
+        };
+
+        struct Block
+        {
+            Block* next;
+        };
+
+        EventFreeLists() : heads(), counts(), released(false) {}
+        ~EventFreeLists()
+        {
+            for (Block*& head : heads)
+            {
+                while (Block* block = head)
+                {
+                    head = block->next;
+                    ::operator delete(block);
+                }
+            }
+            released = true;                                // events deleted at thread exit later go directly to heap
+        }
+
+        Block* heads[SIZE_CLASSES];
+        uint32 counts[SIZE_CLASSES];
+        bool released;
+    };
+
+    thread_local EventFreeLists eventFreeLists;
+}
+
+void* BasicEvent::operator new(size_t size)
+{
+    size_t sizeClass = (size - 1) / EventFreeLists::GRANULARITY;
+    if (sizeClass >= EventFreeLists::SIZE_CLASSES)
+        return ::operator new(size);
+
+    EventFreeLists& lists = eventFreeLists;
+    if (EventFreeLists::Block* block = lists.heads[sizeClass])
+    {
+        lists.heads[sizeClass] = block->next;
+        --lists.counts[sizeClass];
+        return block;
+    }
+
+    return ::operator new((sizeClass + 1) * EventFreeLists::GRANULARITY);
+}
+
+void BasicEvent::operator delete(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t sizeClass = (size - 1) / EventFreeLists::GRANULARITY;
+    EventFreeLists& lists = eventFreeLists;
+    if (sizeClass >= EventFreeLists::SIZE_CLASSES || lists.released || lists.counts[sizeClass] >= EventFreeLists::MAX_FREE_BLOCKS)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    EventFreeLists::Block* block = static_cast<EventFreeLists::Block*>(ptr);
+    block->next = lists.heads[sizeClass];
+    lists.heads[sizeClass] = block;
+    ++lists.counts[sizeClass];
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_wheelTime = 0;
+    memset(m_slotMask, 0, sizeof(m_slotMask));
+    memset(m_slots, 0, sizeof(m_slots));
 }
 
 EventProcessor::~EventProcessor()
@@ -34,17 +115,18 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
+    // move events planned up to now into due slot
+    AdvanceWheel(m_time);
+
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (BasicEvent* Event = m_slots[WHEEL_DUE_SLOT])
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        Unlink(Event);
 
         if (!Event->to_Abort)
         {
-            if (Event->Execute(m_time, p_time))
+            if (Event->Execute(Event->m_execTime, p_time))
             {
                 // completely destroy event if it is not re-added
                 delete Event;
@@ -64,50 +146,215 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (uint32 slot = 0; slot < WHEEL_SLOT_COUNT; ++slot)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* event = m_slots[slot];
+        if (!event)
+            continue;
+
+        // detach slot list, non deletable events are linked back
+        event->m_wheelPrev->m_wheelNext = nullptr;
+        m_slots[slot] = nullptr;
+        if (slot < WHEEL_OVERFLOW_SLOT)
+            m_slotMask[slot >> WHEEL_SLOT_BITS] &= ~(1u << (slot & (WHEEL_SLOTS - 1)));
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        while (event)
         {
-            delete i_old->second;
+            BasicEvent* next = event->m_wheelNext;
+            event->m_wheelNext = event->m_wheelPrev = nullptr;
+            event->m_wheelSlot = -1;
+
+            event->to_Abort = true;
+            event->Abort(m_time);
+            if (force || event->IsDeletable())
+                delete event;
+            else                                            // need per-element cleanup
+                Link(event, slot);
 
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+            event = next;
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    if (!event->IsQueued())
+        return;
+
+    Unlink(event);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
+    if (Event->IsQueued())
+        Unlink(Event);
+
     if (set_addtime)
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Schedule(Event);
+}
+
+bool EventProcessor::RescheduleEvent(BasicEvent* Event, uint64 e_time)
+{
+    if (!Event->IsQueued())
+        return false;
+
+    Unlink(Event);
+    Event->m_execTime = e_time;
+    Schedule(Event);
+    return true;
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::Link(BasicEvent* event, uint32 slot)
+{
+    BasicEvent*& head = m_slots[slot];
+    if (head)
+    {
+        // append at end to keep insertion order of events with same time
+        event->m_wheelNext = head;
+        event->m_wheelPrev = head->m_wheelPrev;
+        head->m_wheelPrev->m_wheelNext = event;
+        head->m_wheelPrev = event;
+    }
+    else
+    {
+        head = event;
+        event->m_wheelNext = event->m_wheelPrev = event;
+        if (slot < WHEEL_OVERFLOW_SLOT)
+            m_slotMask[slot >> WHEEL_SLOT_BITS] |= 1u << (slot & (WHEEL_SLOTS - 1));
+    }
+
+    event->m_wheelSlot = int32(slot);
+}
+
+void EventProcessor::Unlink(BasicEvent* event)
+{
+    uint32 slot = uint32(event->m_wheelSlot);
+    BasicEvent*& head = m_slots[slot];
+    if (event->m_wheelNext == event)
+    {
+        head = nullptr;
+        if (slot < WHEEL_OVERFLOW_SLOT)
+            m_slotMask[slot >> WHEEL_SLOT_BITS] &= ~(1u << (slot & (WHEEL_SLOTS - 1)));
+    }
+    else
+    {
+        event->m_wheelPrev->m_wheelNext = event->m_wheelNext;
+        event->m_wheelNext->m_wheelPrev = event->m_wheelPrev;
+        if (head == event)
+            head = event->m_wheelNext;
+    }
+
+    event->m_wheelNext = event->m_wheelPrev = nullptr;
+    event->m_wheelSlot = -1;
+}
+
+void EventProcessor::Schedule(BasicEvent* event)
+{
+    uint64 time = event->m_execTime;
+    uint32 slot = WHEEL_OVERFLOW_SLOT;
+
+    if (time <= m_wheelTime)
+        slot = WHEEL_DUE_SLOT;
+    else
+    {
+        // lowest level which current rotation contains the time
+        for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+        {
+            uint32 shift = level * WHEEL_SLOT_BITS;
+            if ((time >> (shift + WHEEL_SLOT_BITS)) == (m_wheelTime >> (shift + WHEEL_SLOT_BITS)))
+            {
+                slot = level * WHEEL_SLOTS + uint32((time >> shift) & (WHEEL_SLOTS - 1));
+                break;
+            }
+        }
+    }
+
+    Link(event, slot);
+}
+
+void EventProcessor::Cascade(uint32 slot)
+{
+    BasicEvent* event = m_slots[slot];
+    if (!event)
+        return;
+
+    // detach slot list and schedule its events again for current wheel time
+    event->m_wheelPrev->m_wheelNext = nullptr;
+    m_slots[slot] = nullptr;
+    if (slot < WHEEL_OVERFLOW_SLOT)
+        m_slotMask[slot >> WHEEL_SLOT_BITS] &= ~(1u << (slot & (WHEEL_SLOTS - 1)));
+
+    while (event)
+    {
+        BasicEvent* next = event->m_wheelNext;
+        Schedule(event);
+        event = next;
+    }
+}
+
+void EventProcessor::AdvanceWheel(uint64 time)
+{
+    while (m_wheelTime < time)
+    {
+        // only due events or none, wheel position can be moved freely
+        bool empty = !m_slots[WHEEL_OVERFLOW_SLOT];
+        for (uint32 level = 0; empty && level < WHEEL_LEVELS; ++level)
+            empty = !m_slotMask[level];
+
+        if (empty)
+        {
+            m_wheelTime = time;
+            return;
+        }
+
+        // next used slot of lowest level in current rotation
+        uint32 position = uint32(m_wheelTime & (WHEEL_SLOTS - 1));
+        uint32 pending = position + 1 < WHEEL_SLOTS ? m_slotMask[0] & (~0u << (position + 1)) : 0;
+        if (pending)
+        {
+            uint32 index = 0;
+            while (!(pending & (1u << index)))
+                ++index;
+
+            uint64 slotTime = (m_wheelTime & ~uint64(WHEEL_SLOTS - 1)) | index;
+            if (slotTime > time)
+                break;
+
+            m_wheelTime = slotTime;
+            Cascade(index);                                 // all events of the slot are due now
+            continue;
+        }
+
+        // lowest level rotation is done, enter next one
+        uint64 nextRotation = (m_wheelTime | (WHEEL_SLOTS - 1)) + 1;
+        if (nextRotation > time)
+            break;
+
+        m_wheelTime = nextRotation;
+
+        // move down events of higher level slots which range is entered, starting at highest wrapped level
+        uint32 topLevel = 1;
+        while (topLevel < WHEEL_LEVELS && ((nextRotation >> (topLevel * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1)) == 0)
+            ++topLevel;
+
+        if (topLevel == WHEEL_LEVELS)
+        {
+            Cascade(WHEEL_OVERFLOW_SLOT);
+            --topLevel;
+        }
+
+        for (uint32 level = topLevel; level > 0; --level)
+            Cascade(level * WHEEL_SLOTS + uint32((nextRotation >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1)));
+    }
+
+    m_wheelTime = time;
+}
@@ -21,16 +21,18 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+        friend class EventProcessor;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_addTime(0), m_execTime(0), m_wheelNext(nullptr), m_wheelPrev(nullptr), m_wheelSlot(-1)
         {
         }
 
@@ -38,6 +40,10 @@ class BasicEvent
         {
         };
 
+        // events are small and created often, memory of deleted ones is kept in per thread free lists
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
         // e_time is execution time, p_time is update interval
@@ -47,16 +53,24 @@ class BasicEvent
 
         virtual void Abort(uint64 /*e_time*/) {}            // this method executes when the event is aborted
 
+        bool IsQueued() const { return m_wheelSlot >= 0; } // false while not added or being executed
+
         bool to_Abort;                                      // set by externals when the event is aborted, aborted events don't execute
         // and get Abort call when deleted
 
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        // links in circular list of the timer wheel slot the event is queued in
+        BasicEvent* m_wheelNext;
+        BasicEvent* m_wheelPrev;
+        int32 m_wheelSlot;
+};
 
+// events are kept in hierarchical timer wheel, adding, moving and removing an event is O(1)
+// lowest level slots hold single milliseconds, higher level slots are moved down when the wheel time reaches them
 class EventProcessor
 {
     public:
@@ -68,14 +82,58 @@ class EventProcessor
         void KillAllEvents(bool force);
         void KillEvent(BasicEvent* Event);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
+        bool RescheduleEvent(BasicEvent* Event, uint64 e_time); // moves queued event, false if it is not queued
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
+
+        // visitor may kill or move the visited event, but not other events
+        template<typename F>
+        void VisitEvents(F const& visitor)
+        {
+            std::vector<BasicEvent*> events;
+            for (BasicEvent* head : m_slots)
+            {
+                if (!head)
+                    continue;
+
+                BasicEvent* event = head;
+                do
+                {
+                    events.push_back(event);
+                    event = event->m_wheelNext;
+                }
+                while (event != head);
+            }
+
+            for (BasicEvent* event : events)
+                visitor(event);
+        }
 
     protected:
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+
+        enum
+        {
+            WHEEL_SLOT_BITS     = 5,
+            WHEEL_SLOTS         = 1 << WHEEL_SLOT_BITS,
+            WHEEL_LEVELS        = 3,                        // 32 ms, ~1 s and ~32 s ranges
+            WHEEL_OVERFLOW_SLOT = WHEEL_LEVELS * WHEEL_SLOTS, // farther events, sorted again when top level wraps
+            WHEEL_DUE_SLOT,                                 // events to execute, in time order
+            WHEEL_SLOT_COUNT
+        };
+
+        void Link(BasicEvent* event, uint32 slot);
+        void Unlink(BasicEvent* event);
+        void Schedule(BasicEvent* event);
+        void Cascade(uint32 slot);
+        void AdvanceWheel(uint64 time);
+
+        uint64 m_wheelTime;                                 // events planned up to this time are in due slot
+        uint32 m_slotMask[WHEEL_LEVELS];                    // non empty slots of each level
+        BasicEvent* m_slots[WHEEL_SLOT_COUNT];              // first event of each slot
 };
 
 #endif
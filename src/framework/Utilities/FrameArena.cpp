@@ -0,0 +1,93 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "FrameArena.h"
+
+namespace
+{
+    thread_local FrameArena threadArena;
+    thread_local FrameArena* currentArena = nullptr;
+}
+
+FrameArena::FrameArena() : m_currentChunk(0), m_chunkOffset(0), m_usedBytes(0), m_depth(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    Reset();
+    for (char* chunk : m_chunks)
+        ::operator delete(chunk);
+}
+
+void* FrameArena::Allocate(size_t size)
+{
+    size = (size + ALIGNMENT - 1) & ~size_t(ALIGNMENT - 1);
+    m_usedBytes += size;
+
+    if (size > CHUNK_SIZE)
+    {
+        m_largeBlocks.push_back(::operator new(size));
+        return m_largeBlocks.back();
+    }
+
+    if (m_chunks.empty() || m_chunkOffset + size > CHUNK_SIZE)
+    {
+        // next kept chunk, new one only when all are used in this frame
+        if (!m_chunks.empty())
+            ++m_currentChunk;
+        if (m_currentChunk >= m_chunks.size())
+            m_chunks.push_back(static_cast<char*>(::operator new(CHUNK_SIZE)));
+        m_chunkOffset = 0;
+    }
+
+    void* ptr = m_chunks[m_currentChunk] + m_chunkOffset;
+    m_chunkOffset += size;
+    return ptr;
+}
+
+FrameArena* FrameArena::GetCurrent()
+{
+    return currentArena;
+}
+
+void FrameArena::Reset()
+{
+    for (void* block : m_largeBlocks)
+        ::operator delete(block);
+    m_largeBlocks.clear();
+
+    m_currentChunk = 0;
+    m_chunkOffset = 0;
+    m_usedBytes = 0;
+}
+
+FrameArenaScope::FrameArenaScope() : m_arena(threadArena)
+{
+    if (m_arena.m_depth++ == 0)
+        currentArena = &m_arena;
+}
+
+FrameArenaScope::~FrameArenaScope()
+{
+    if (--m_arena.m_depth == 0)
+    {
+        currentArena = nullptr;
+        m_arena.Reset();
+    }
+}
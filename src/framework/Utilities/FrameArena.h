@@ -0,0 +1,111 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef __FRAMEARENA_H
+#define __FRAMEARENA_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Monotonic memory of one update frame, allocations are only bumped and all are released together at frame end.
+// Every thread has own arena, frame is opened by FrameArenaScope. Containers using FrameArenaAllocator must not
+// outlive the frame they are created in, outside of a frame they use the heap.
+class FrameArena
+{
+        friend class FrameArenaScope;
+
+    public:
+        FrameArena();
+        ~FrameArena();
+
+        void* Allocate(size_t size);
+
+        // arena of the frame open in this thread, nullptr if none
+        static FrameArena* GetCurrent();
+
+        size_t GetUsedBytes() const { return m_usedBytes; }
+        size_t GetReservedBytes() const { return m_chunks.size() * CHUNK_SIZE; }
+
+    private:
+        enum
+        {
+            CHUNK_SIZE = 64 * 1024,
+            ALIGNMENT = 16
+        };
+
+        void Reset();
+
+        std::vector<char*> m_chunks;                        // kept between frames
+        std::vector<void*> m_largeBlocks;                   // larger than chunk, freed at frame end
+        size_t m_currentChunk;
+        size_t m_chunkOffset;
+        size_t m_usedBytes;
+        uint32 m_depth;                                     // nested scopes, reset at outermost end
+};
+
+class FrameArenaScope
+{
+    public:
+        FrameArenaScope();
+        ~FrameArenaScope();
+
+        FrameArenaScope(FrameArenaScope const&) = delete;
+        FrameArenaScope& operator=(FrameArenaScope const&) = delete;
+
+        FrameArena& GetArena() { return m_arena; }
+
+    private:
+        FrameArena& m_arena;
+};
+
+// STL allocator taking memory from the frame open at container construction, deallocation is a no-op then
+template<class T>
+class FrameArenaAllocator
+{
+        template<class U> friend class FrameArenaAllocator;
+
+    public:
+        typedef T value_type;
+
+        FrameArenaAllocator() : m_arena(FrameArena::GetCurrent()) {}
+        template<class U> FrameArenaAllocator(FrameArenaAllocator<U> const& other) : m_arena(other.m_arena) {}
+
+        T* allocate(size_t n)
+        {
+            if (m_arena)
+                return static_cast<T*>(m_arena->Allocate(n * sizeof(T)));
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, size_t /*n*/)
+        {
+            if (!m_arena)
+                ::operator delete(ptr);
+        }
+
+        template<class U> bool operator==(FrameArenaAllocator<U> const& other) const { return m_arena == other.m_arena; }
+        template<class U> bool operator!=(FrameArenaAllocator<U> const& other) const { return m_arena != other.m_arena; }
+
+    private:
+        FrameArena* m_arena;
+};
+
+#endif
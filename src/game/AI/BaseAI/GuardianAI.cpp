@@ -92,10 +92,6 @@ void GuardianAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    VisitEvents(EVENT_T_EVADE, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i); });
     ProcessEvents();
 }
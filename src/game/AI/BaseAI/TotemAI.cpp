@@ -47,11 +47,7 @@ void TotemAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    VisitEvents(EVENT_T_EVADE, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i); });
     ProcessEvents();
 }
 
@@ -73,6 +73,7 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
         return;
 
     reader.PSendSysMessage("Current events of this creature:");
+    DecrementEventTimers();
     for (CreatureEventAIList::const_iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
     {
         if (itr->event.action[2].type != ACTION_T_NONE)
@@ -87,6 +88,7 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
 CreatureEventAI::CreatureEventAI(Creature* creature) : CreatureAI(creature),
     m_EventUpdateTime(0),
     m_EventDiff(0),
+    m_EventTimerMin(0),
     m_Phase(0),
     m_HasOOCLoSEvent(false),
     m_InvinceabilityHpLevel(0),
@@ -128,6 +130,7 @@ void CreatureEventAI::InitAI()
         else
         {
             m_CreatureEventAIList.reserve(events_count);
+            m_eventTypeIndex = sEventAIMgr.GetEventTypeIndex(m_creature->GetEntry());
             for (const auto& i : creatureEvent)
             {
                 // Debug check
@@ -170,7 +173,7 @@ void CreatureEventAI::InitAI()
     }
 }
 
-bool CreatureEventAI::IsTimerExecutedEvent(EventAI_Type type) const
+bool CreatureEventAI::IsTimerExecutedEvent(EventAI_Type type)
 {
     switch (type)
     {
@@ -552,6 +555,8 @@ void CreatureEventAI::ResetEvent(CreatureEventAIHolder& holder)
 {
     if (IsTimerBasedEvent(holder.event.event_type))
     {
+        PrepareEventTimerChange();
+
         uint32 repeatMin, repeatMax;
         GetRepeatTimers(holder, repeatMin, repeatMax);
         holder.UpdateRepeatTimer(m_creature, repeatMin, repeatMax);
@@ -956,11 +961,13 @@ bool CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             break;
         }
         case ACTION_T_SET_PHASE:
+            PrepareEventTimerChange();
             m_Phase = action.set_phase.phase;
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "%s: ACTION_T_SET_PHASE - script %u for %s, phase is now %u", GetAIName().data(), eventId, m_creature->GetGuidStr().c_str(), m_Phase);
             break;
         case ACTION_T_INC_PHASE:
         {
+            PrepareEventTimerChange();
             int32 new_phase = int32(m_Phase) + action.set_inc_phase.step;
             if (new_phase < 0)
             {
@@ -1024,10 +1031,12 @@ bool CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
             }
             break;
         case ACTION_T_RANDOM_PHASE:
+            PrepareEventTimerChange();
             m_Phase = GetRandActionParam(rnd, action.random_phase.phase1, action.random_phase.phase2, action.random_phase.phase3);
             DEBUG_FILTER_LOG(LOG_FILTER_EVENT_AI_DEV, "%s: ACTION_T_RANDOM_PHASE - script %u for %s, phase is now %u", GetAIName().data(), eventId, m_creature->GetGuidStr().c_str(), m_Phase);
             break;
         case ACTION_T_RANDOM_PHASE_RANGE:
+            PrepareEventTimerChange();
             if (action.random_phase_range.phaseMax > action.random_phase_range.phaseMin)
                 m_Phase = rnd % (action.random_phase_range.phaseMax - action.random_phase_range.phaseMin + 1) + action.random_phase_range.phaseMin;
             else
@@ -1355,7 +1364,7 @@ bool CreatureEventAI::ProcessAction(CreatureEventAI_Action const& action, uint32
 void CreatureEventAI::JustRespawned()                       // NOTE that this is called from the AI's constructor as well
 {
     m_EventUpdateTime = EVENT_UPDATE_TIME;
-    m_EventDiff = 0;
+    PrepareEventTimerChange();
     m_throwAIEventStep = 0;
     m_LastSpellMaxRange = 0;
 
@@ -1388,7 +1397,7 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
 void CreatureEventAI::Reset()
 {
     m_EventUpdateTime = EVENT_UPDATE_TIME;
-    m_EventDiff = 0;
+    PrepareEventTimerChange();
     m_throwAIEventStep = 0;
     m_LastSpellMaxRange = 0;
     m_currentRangedMode = m_rangedMode;
@@ -1424,11 +1433,7 @@ void CreatureEventAI::Reset()
 void CreatureEventAI::JustReachedHome()
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_REACHED_HOME)
-            CheckAndReadyEventForExecution(i);
-    }
+    VisitEvents(EVENT_T_REACHED_HOME, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i); });
     ProcessEvents();
 
     Reset();
@@ -1440,11 +1445,7 @@ void CreatureEventAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    VisitEvents(EVENT_T_EVADE, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i); });
     ProcessEvents();
 }
 
@@ -1457,58 +1458,39 @@ void CreatureEventAI::JustDied(Unit* killer)
 
     // Handle On Death events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_DEATH)
-            CheckAndReadyEventForExecution(i, killer);
-    }
+    VisitEvents(EVENT_T_DEATH, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, killer); });
     ProcessEvents(killer);
 
     // reset phase after any death state events
+    PrepareEventTimerChange();
     m_Phase = 0;
 }
 
 void CreatureEventAI::KilledUnit(Unit* victim)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_KILL)
-            CheckAndReadyEventForExecution(i, victim);
-    }
+    VisitEvents(EVENT_T_KILL, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, victim); });
     ProcessEvents(victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_UNIT)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    VisitEvents(EVENT_T_SUMMONED_UNIT, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, summoned); });
     ProcessEvents(summoned);
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    VisitEvents(EVENT_T_SUMMONED_JUST_DIED, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, summoned); });
     ProcessEvents(summoned);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    VisitEvents(EVENT_T_SUMMONED_JUST_DESPAWN, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, summoned); });
     ProcessEvents(summoned);
 }
 
@@ -1517,12 +1499,11 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Unit* sender, Unit*
     MANGOS_ASSERT(sender);
 
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    VisitEvents(EVENT_T_RECEIVE_AI_EVENT, [&](CreatureEventAIHolder& itr)
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
+        if (itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
             CheckAndReadyEventForExecution(itr, invoker, sender);
-    }
+    });
     ProcessEvents(invoker, sender);
 }
 
@@ -1530,6 +1511,7 @@ void CreatureEventAI::EnterCombat(Unit* enemy)
 {
     // Check for on combat start events
     IncreaseDepthIfNecessary();
+    PrepareEventTimerChange();
     for (auto& i : m_CreatureEventAIList)
     {
         CreatureEventAI_Event const& event = i.event;
@@ -1567,27 +1549,24 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     IncreaseDepthIfNecessary();
     if (m_HasOOCLoSEvent && !m_creature->getVictim())
     {
-        for (auto& itr : m_CreatureEventAIList)
+        VisitEvents(EVENT_T_OOC_LOS, [&](CreatureEventAIHolder& itr)
         {
-            if (itr.event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
 
-                // who must be player type if this option is turned on
-                if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            // who must be player type if this option is turned on
+            if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            {
+                // if friendly event && who is not hostile OR hostile event && who is hostile
+                if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
+                        ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
                 {
-                    // if friendly event && who is not hostile OR hostile event && who is hostile
-                    if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
-                            ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
-                    {
-                        // if range is ok and we are actually in LOS
-                        if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                            CheckAndReadyEventForExecution(itr, who);
-                    }
+                    // if range is ok and we are actually in LOS
+                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+                        CheckAndReadyEventForExecution(itr, who);
                 }
             }
-        }
+        });
         ProcessEvents(who);
     }
 
@@ -1597,12 +1576,13 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
-                if (GetSchoolMask(spellInfo->School) & i.event.spell_hit.schoolMask)
-                    CheckAndReadyEventForExecution(i, unit);
+    VisitEvents(EVENT_T_SPELLHIT, [&](CreatureEventAIHolder& i)
+    {
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
+            if (GetSchoolMask(spellInfo->School) & i.event.spell_hit.schoolMask)
+                CheckAndReadyEventForExecution(i, unit);
+    });
 
     ProcessEvents(unit);
 }
@@ -1610,12 +1590,13 @@ void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 void CreatureEventAI::SpellHitTarget(Unit* target, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT_TARGET)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
-                if (GetSchoolMask(spellInfo->School) & i.event.spell_hit_target.schoolMask)
-                    CheckAndReadyEventForExecution(i, target);
+    VisitEvents(EVENT_T_SPELLHIT_TARGET, [&](CreatureEventAIHolder& i)
+    {
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
+            if (GetSchoolMask(spellInfo->School) & i.event.spell_hit_target.schoolMask)
+                CheckAndReadyEventForExecution(i, target);
+    });
 
     ProcessEvents(target);
 }
@@ -1794,16 +1775,11 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(CreatureList& list, float range,
 void CreatureEventAI::ReceiveEmote(Player* player, uint32 textEmote)
 {
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    VisitEvents(EVENT_T_RECEIVE_EMOTE, [&](CreatureEventAIHolder& itr)
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if (itr.event.receive_emote.emoteId != textEmote)
-                continue;
-
+        if (itr.event.receive_emote.emoteId == textEmote)
             CheckAndReadyEventForExecution(itr, player);
-        }
-    }
+    });
     ProcessEvents(player);
 }
 
@@ -1844,10 +1820,7 @@ void CreatureEventAI::DamageTaken(Unit* dealer, uint32& damage, DamageEffectType
 void CreatureEventAI::JustPreventedDeath(Unit* attacker)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_DEATH_PREVENTED)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            CheckAndReadyEventForExecution(i, attacker);
+    VisitEvents(EVENT_T_DEATH_PREVENTED, [&](CreatureEventAIHolder& i) { CheckAndReadyEventForExecution(i, attacker); });
 
     ProcessEvents(attacker);
 }
@@ -1899,33 +1872,27 @@ void CreatureEventAI::UpdateEventTimers(const uint32 diff)
     {
         m_EventDiff += diff;
 
+        // No timer can have expired before the lowest one, keep the time for later
+        if (m_EventDiff >= m_EventTimerMin)
+            DecrementEventTimers();
+
         // Check for time based events
-        IncreaseDepthIfNecessary();
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        if (m_eventTypeIndex && !m_eventTypeIndex->timerExecutedEvents.empty())
         {
-            // Decrement Timers
-            if (i->timer)
+            IncreaseDepthIfNecessary();
+            for (uint16 pos : m_eventTypeIndex->timerExecutedEvents)
             {
-                // Do not decrement timers if event cannot trigger in this phase
-                if (!(i->event.event_inverse_phase_mask & (1 << m_Phase)))
-                {
-                    if (i->timer > m_EventDiff)
-                        i->timer -= m_EventDiff;
-                    else
-                        i->timer = 0;
-                }
-            }
+                CreatureEventAIHolder& holder = m_CreatureEventAIList[pos];
 
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->enabled) || i->timer)
-                continue;
+                // Skip processing of events that have time remaining or are disabled
+                if (!holder.enabled || holder.timer)
+                    continue;
 
-            if (IsTimerExecutedEvent(i->event.event_type))
-                CheckAndReadyEventForExecution(*i);
+                CheckAndReadyEventForExecution(holder);
+            }
+            ProcessEvents();
         }
-        ProcessEvents();
 
-        m_EventDiff = 0;
         m_EventUpdateTime = EVENT_UPDATE_TIME;
     }
     else
@@ -1935,6 +1902,34 @@ void CreatureEventAI::UpdateEventTimers(const uint32 diff)
     }
 }
 
+void CreatureEventAI::DecrementEventTimers()
+{
+    m_EventTimerMin = std::numeric_limits<uint32>::max();
+    for (auto& holder : m_CreatureEventAIList)
+    {
+        // Do not decrement timers if event cannot trigger in this phase
+        if (!holder.timer || (holder.event.event_inverse_phase_mask & (1 << m_Phase)))
+            continue;
+
+        if (holder.timer > m_EventDiff)
+        {
+            holder.timer -= m_EventDiff;
+            m_EventTimerMin = std::min(m_EventTimerMin, holder.timer);
+        }
+        else
+            holder.timer = 0;
+    }
+
+    m_EventDiff = 0;
+}
+
+// Must be called before event timers or phase change, as passed time is not yet subtracted from them
+void CreatureEventAI::PrepareEventTimerChange()
+{
+    DecrementEventTimers();
+    m_EventTimerMin = 0;                                    // new timers are not known, walk them on next update
+}
+
 void CreatureEventAI::SetRangedMode(bool state, float distance, RangeModeType type)
 {
     if (m_rangedMode == state)
@@ -23,6 +23,7 @@
 #include "Entities/Creature.h"
 #include "../BaseAI/CreatureAI.h"
 #include "Entities/Unit.h"
+#include <memory>
 #include <set>
 
 class Player;
@@ -762,6 +763,15 @@ typedef std::vector<CreatureEventAI_Event> CreatureEventAI_Event_Vec;
 typedef std::unordered_map<uint32, CreatureEventAI_Event_Vec> CreatureEventAI_Event_Map;
 typedef std::unordered_map<uint32, CreatureEventAI_EventComputedData> CreatureEventAI_EventComputedData_Map;
 
+// Events of a creature entry grouped by event type, positions match CreatureEventAI::m_CreatureEventAIList
+struct CreatureEventAI_EventTypeIndex
+{
+    std::vector<uint16> events;                             // positions ordered by event type, database order within type
+    uint16 typeStart[EVENT_T_END + 1];                      // events of type T are events[typeStart[T]] .. events[typeStart[T + 1] - 1]
+    std::vector<uint16> timerExecutedEvents;                // positions of events checked at event timer update, database order
+};
+typedef std::unordered_map<uint32, std::shared_ptr<CreatureEventAI_EventTypeIndex const> > CreatureEventAI_EventTypeIndex_Map;
+
 struct CreatureEventAI_Summon
 {
     uint32 id;
@@ -833,6 +843,16 @@ class CreatureEventAI : public CreatureAI
         void ResetEvent(CreatureEventAIHolder& holder);
         void CheckAndReadyEventForExecution(CreatureEventAIHolder& holder, Unit* actionInvoker = nullptr, Unit* AIEventSender = nullptr);
         void IncreaseDepthIfNecessary() { if (m_depth >= m_creatureEventAITempList.size()) m_creatureEventAITempList.resize(m_depth + 1); }
+        // Calls visitor for every event of given type, in database order
+        template<typename Visitor>
+        void VisitEvents(EventAI_Type type, Visitor&& visitor)
+        {
+            if (!m_eventTypeIndex)
+                return;
+
+            for (uint16 i = m_eventTypeIndex->typeStart[type]; i < m_eventTypeIndex->typeStart[type + 1]; ++i)
+                visitor(m_CreatureEventAIList[m_eventTypeIndex->events[i]]);
+        }
         virtual bool ProcessEvent(CreatureEventAIHolder& holder, Unit* actionInvoker = nullptr, Unit* AIEventSender = nullptr);
         virtual bool ProcessAction(CreatureEventAI_Action const& action, uint32 rnd, uint32 eventId, Unit* actionInvoker, Unit* AIEventSender, Unit* eventTarget);
         inline uint32 GetRandActionParam(uint32 rnd, uint32 param1, uint32 param2, uint32 param3) const;
@@ -855,21 +875,27 @@ class CreatureEventAI : public CreatureAI
         void DistancingEnded() override;
 
         MovementGeneratorType GetDefaultMovement() { return m_defaultMovement; }
+
+        static bool IsTimerExecutedEvent(EventAI_Type type);
     protected:
         std::string GetAIName() override { return "EventAI"; }
         // Event rules specifiers
-        bool IsTimerExecutedEvent(EventAI_Type type) const;
         bool IsRepeatableEvent(EventAI_Type type) const;
         bool IsTimerBasedEvent(EventAI_Type type) const;
         // Event rules specifiers end
         void DistanceYourself();
 
+        void DecrementEventTimers();
+        void PrepareEventTimerChange();
+
         uint32 m_EventUpdateTime;                           // Time between event updates
-        uint32 m_EventDiff;                                 // Time between the last event call
+        uint32 m_EventDiff;                                 // Time not yet subtracted from event timers
+        uint32 m_EventTimerMin;                             // Lowest running event timer, timers are only walked once it may have expired
 
         // Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
+        std::shared_ptr<CreatureEventAI_EventTypeIndex const> m_eventTypeIndex; // Shared per entry, kept alive across script reload
         std::vector<std::vector<std::reference_wrapper<CreatureEventAIHolder>>> m_creatureEventAITempList; // Holder for events that are ready to go off
         uint32 m_depth;
 
@@ -252,10 +252,45 @@ bool IsValidTargetType(EventAI_Type eventType, EventAI_ActionType actionType, ui
 }
 
 // -------------------
+// Group events of each entry by type, so AI callbacks do not walk all events of a creature
+void CreatureEventAIMgr::BuildEventTypeIndex()
+{
+    for (CreatureEventAI_Event_Map::const_iterator itr = m_CreatureEventAI_Event_Map.begin(); itr != m_CreatureEventAI_Event_Map.end(); ++itr)
+    {
+        std::vector<uint16> typeEvents[EVENT_T_END];
+        std::shared_ptr<CreatureEventAI_EventTypeIndex> index = std::make_shared<CreatureEventAI_EventTypeIndex>();
+
+        // same filter as CreatureEventAI::InitAI
+        uint16 pos = 0;
+        for (const auto& event : itr->second)
+        {
+#ifndef MANGOS_DEBUG
+            if (event.event_flags & EFLAG_DEBUG_ONLY)
+                continue;
+#endif
+            typeEvents[event.event_type].push_back(pos);
+            if (CreatureEventAI::IsTimerExecutedEvent(EventAI_Type(event.event_type)))
+                index->timerExecutedEvents.push_back(pos);
+            ++pos;
+        }
+
+        index->events.reserve(pos);
+        for (uint32 type = 0; type < EVENT_T_END; ++type)
+        {
+            index->typeStart[type] = uint16(index->events.size());
+            index->events.insert(index->events.end(), typeEvents[type].begin(), typeEvents[type].end());
+        }
+        index->typeStart[EVENT_T_END] = uint16(index->events.size());
+
+        m_CreatureEventAI_EventTypeIndex_Map[itr->first] = index;
+    }
+}
+
 void CreatureEventAIMgr::LoadCreatureEventAI_Scripts()
 {
     // Drop Existing EventAI List
     m_CreatureEventAI_Event_Map.clear();
+    m_CreatureEventAI_EventTypeIndex_Map.clear();
     std::set<int32> usedTextIds;
 
     // Gather event data
@@ -1098,6 +1133,8 @@ void CreatureEventAIMgr::LoadCreatureEventAI_Scripts()
         delete result;
         m_usedTextsAmount = usedTextIds.size();
 
+        BuildEventTypeIndex();
+
         // post check
         for (uint32 i = 1; i < sCreatureStorage.GetMaxEntry(); ++i)
         {
@@ -35,14 +35,21 @@ class CreatureEventAIMgr
         CreatureEventAI_Event_Map  const& GetCreatureEventAIMap()       const { return m_CreatureEventAI_Event_Map; }
         CreatureEventAI_Summon_Map const& GetCreatureEventAISummonMap() const { return m_CreatureEventAI_Summon_Map; }
         CreatureEventAI_EventComputedData_Map const& GetEAIComputedDataMap() const { return m_creatureEventAI_ComputedDataMap; }
+        std::shared_ptr<CreatureEventAI_EventTypeIndex const> GetEventTypeIndex(uint32 entry) const
+        {
+            CreatureEventAI_EventTypeIndex_Map::const_iterator itr = m_CreatureEventAI_EventTypeIndex_Map.find(entry);
+            return itr != m_CreatureEventAI_EventTypeIndex_Map.end() ? itr->second : nullptr;
+        }
 
     private:
         void CheckUnusedAITexts();
         void CheckUnusedAISummons();
+        void BuildEventTypeIndex();
 
         CreatureEventAI_Event_Map  m_CreatureEventAI_Event_Map;
         CreatureEventAI_Summon_Map m_CreatureEventAI_Summon_Map;
         CreatureEventAI_EventComputedData_Map m_creatureEventAI_ComputedDataMap;
+        CreatureEventAI_EventTypeIndex_Map m_CreatureEventAI_EventTypeIndex_Map;
 
         uint32 m_usedTextsAmount;
 };
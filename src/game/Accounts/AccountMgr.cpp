@@ -30,7 +30,7 @@ extern DatabaseType LoginDatabase;
 
 INSTANTIATE_SINGLETON_1(AccountMgr);
 
-AccountMgr::AccountMgr()
+AccountMgr::AccountMgr() : m_credentialsVersion(0)
 {}
 
 AccountMgr::~AccountMgr()
@@ -107,6 +107,8 @@ AccountOpResult AccountMgr::DeleteAccount(uint32 accid) const
 
     LoginDatabase.CommitTransaction();
 
+    UpdateCredentialsVersion();
+
     if (!res)
         return AOR_DB_INTERNAL_ERROR;                       // unexpected error;
 
@@ -146,6 +148,8 @@ AccountOpResult AccountMgr::ChangeUsername(uint32 accid, std::string new_uname,
     OPENSSL_free((void*)s_hex);
     OPENSSL_free((void*)v_hex);
 
+    UpdateCredentialsVersion();
+
     if (!update_sv)
         return AOR_DB_INTERNAL_ERROR;                       // unexpected error
 
@@ -179,6 +183,8 @@ AccountOpResult AccountMgr::ChangePassword(uint32 accid, std::string new_passwd)
     OPENSSL_free((void*)s_hex);
     OPENSSL_free((void*)v_hex);
 
+    UpdateCredentialsVersion();
+
     // also reset s and v to force update at next realmd login
     if (!update_sv)
         return AOR_DB_INTERNAL_ERROR;                       // unexpected error
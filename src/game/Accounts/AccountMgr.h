@@ -21,6 +21,8 @@
 
 #include "Common.h"
 
+#include <atomic>
+
 enum AccountOpResult
 {
     AOR_OK,
@@ -52,6 +54,14 @@ class AccountMgr
         std::string CalculateShaPassHash(std::string& name, std::string& password) const;
 
         static bool normalizeString(std::string& utf8str);
+
+        // changed at every password, username, gm level or delete change of any account done by this server
+        // remote access caching verified credentials drops them when it changed
+        uint32 GetCredentialsVersion() const { return m_credentialsVersion; }
+        void UpdateCredentialsVersion() const { ++m_credentialsVersion; }
+
+    private:
+        mutable std::atomic<uint32> m_credentialsVersion;
 };
 
 #define sAccountMgr MaNGOS::Singleton<AccountMgr>::Instance()
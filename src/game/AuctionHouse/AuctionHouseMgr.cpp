@@ -524,27 +524,35 @@ void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
     ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    while (!m_expireQueue.empty() && m_expireQueue.top().first <= curTime)
     {
-        if (curTime < itr->second->expireTime)
+        AuctionExpireTime expire = m_expireQueue.top();
+        m_expireQueue.pop();
+
+        AuctionEntryMap::iterator itr = AuctionsMap.find(expire.second);
+        if (itr == AuctionsMap.end())                       // already sold or cancelled
+            continue;
+
+        AuctionEntry* auction = itr->second;
+        if (curTime < auction->expireTime)                  // expire time was extended, wait for it
         {
-            itr++;
+            m_expireQueue.push(AuctionExpireTime(auction->expireTime, auction->Id));
             continue;
         }
 
         ///- perform the transaction if there was bidder.  this will alyways have the side effect of
-        ///- removing the auction from the collection.  therefore we must increment the iterator here.
-        if (itr->second->bid)
-            (itr++)->second->AuctionBidWinning();
+        ///- removing the auction from the collection.
+        if (auction->bid)
+            auction->AuctionBidWinning();
         ///- cancel the auction if there was no bidder and clear the auction
         else
         {
-            sAuctionMgr.SendAuctionExpiredMail(itr->second);
+            sAuctionMgr.SendAuctionExpiredMail(auction);
 
-            itr->second->DeleteFromDB();
-            sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
-            delete itr->second;
-            AuctionsMap.erase(itr++);
+            auction->DeleteFromDB();
+            sAuctionMgr.RemoveAItem(auction->itemGuidLow);
+            delete auction;
+            AuctionsMap.erase(itr);
         }
     }
 }
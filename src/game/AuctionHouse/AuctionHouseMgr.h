@@ -22,6 +22,8 @@
 #include "Common.h"
 #include "Server/DBCStructure.h"
 
+#include <queue>
+
 class Item;
 class Player;
 class Unit;
@@ -100,6 +102,7 @@ class AuctionHouseObject
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            m_expireQueue.push(AuctionExpireTime(ah->expireTime, ah->Id));
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -110,6 +113,13 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
 
+        // expire time must be changed by this for the auction expire at new time
+        void SetAuctionExpireTime(AuctionEntry* ah, time_t expireTime)
+        {
+            ah->expireTime = expireTime;
+            m_expireQueue.push(AuctionExpireTime(expireTime, ah->Id));
+        }
+
         void Update();
 
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -121,6 +131,11 @@ class AuctionHouseObject
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
         AuctionEntryMap AuctionsMap;
+
+        // soonest expire time first, entries of removed auctions and old expire times are skipped at pop
+        typedef std::pair<time_t, uint32> AuctionExpireTime;
+        typedef std::priority_queue<AuctionExpireTime, std::vector<AuctionExpireTime>, std::greater<AuctionExpireTime> > AuctionExpireQueue;
+        AuctionExpireQueue m_expireQueue;
 };
 
 enum AuctionHouseType
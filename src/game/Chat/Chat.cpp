@@ -272,6 +272,8 @@ ChatCommand* ChatHandler::getCommandTable()
         { "visibility",     SEC_MODERATOR,      false, nullptr,                                             "", debugVisibilityCommandTable },
         { "perf",           SEC_ADMINISTRATOR,  false, nullptr,                                             "", debugPerformanceCommandTable },
         { "lootdropstats",  SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugLootDropStats,              "", nullptr },
+        { "corpselootstats", SEC_ADMINISTRATOR, true,  &ChatHandler::HandleDebugCorpseLootStats,            "", nullptr },
+        { "compressionstats", SEC_ADMINISTRATOR, true, &ChatHandler::HandleDebugCompressionStats,           "", nullptr },
         { "utf8overflow",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugOverflowCommand,            "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
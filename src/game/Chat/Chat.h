@@ -231,6 +231,8 @@ class ChatHandler
         bool HandleDebugSpellVisual(char* args);
         bool HandleDebugMoveflags(char* args);
         bool HandleDebugLootDropStats(char* args);
+        bool HandleDebugCorpseLootStats(char* args);
+        bool HandleDebugCompressionStats(char* args);
         bool HandleDebugOverflowCommand(char* args);
 
         bool HandleDebugHaveAtClientCommand(char* args);
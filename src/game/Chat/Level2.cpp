@@ -3523,6 +3523,7 @@ bool ChatHandler::HandleCharacterRenameCommand(char* args)
 
         PSendSysMessage(LANG_RENAME_PLAYER_GUID, oldNameLink.c_str(), target_guid.GetCounter());
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '1' WHERE guid = '%u'", target_guid.GetCounter());
+        sWorld.InvalidateCharEnum(sObjectMgr.GetPlayerAccountIdByGUID(target_guid));
     }
 
     return true;
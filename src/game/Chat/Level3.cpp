@@ -54,6 +54,7 @@
 #include "AuctionHouseBot/AuctionHouseBot.h"
 #include "Server/SQLStorages.h"
 #include "Loot/LootMgr.h"
+#include "World/ReloadMgr.h"
 
 static uint32 ahbotQualityIds[MAX_AUCTION_QUALITY] =
 {
@@ -253,9 +254,8 @@ bool ChatHandler::HandleReloadAllAreaCommand(char* /*args*/)
 
 bool ChatHandler::HandleReloadAllLootCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables...");
-    LoadLootTables();
-    SendGlobalSysMessage("DB tables `*_loot_template` reloaded.");
+    ReloadLootTemplates("*_loot_template", &LoadLootTables);
+    SendSysMessage("DB tables `*_loot_template` reload started.");
     return true;
 }
 
@@ -417,6 +417,14 @@ bool ChatHandler::HandleReloadCreatureQuestInvRelationsCommand(char* /*args*/)
 
 bool ChatHandler::HandleReloadConditionsCommand(char* /*args*/)
 {
+    // used by loot templates loaded in background
+    if (sReloadMgr.IsLoading())
+    {
+        SendSysMessage("Background reload is in progress, reload `conditions` after it is finished.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
     sLog.outString("Re-Loading `conditions`... ");
     sObjectMgr.LoadConditions();
     SendGlobalSysMessage("DB table `conditions` reloaded.");
@@ -507,81 +515,64 @@ bool ChatHandler::HandleReloadQuestTemplateCommand(char* /*args*/)
 
 bool ChatHandler::HandleReloadLootTemplatesCreatureCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`creature_loot_template`)");
-    LoadLootTemplates_Creature();
-    LootTemplates_Creature.CheckLootRefs();
-    SendGlobalSysMessage("DB table `creature_loot_template` reloaded.");
+    ReloadLootTemplates("creature_loot_template", &LoadLootTemplates_Creature);
+    SendSysMessage("DB table `creature_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesDisenchantCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`disenchant_loot_template`)");
-    LoadLootTemplates_Disenchant();
-    LootTemplates_Disenchant.CheckLootRefs();
-    SendGlobalSysMessage("DB table `disenchant_loot_template` reloaded.");
+    ReloadLootTemplates("disenchant_loot_template", &LoadLootTemplates_Disenchant);
+    SendSysMessage("DB table `disenchant_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesFishingCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`fishing_loot_template`)");
-    LoadLootTemplates_Fishing();
-    LootTemplates_Fishing.CheckLootRefs();
-    SendGlobalSysMessage("DB table `fishing_loot_template` reloaded.");
+    ReloadLootTemplates("fishing_loot_template", &LoadLootTemplates_Fishing);
+    SendSysMessage("DB table `fishing_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesGameobjectCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`gameobject_loot_template`)");
-    LoadLootTemplates_Gameobject();
-    LootTemplates_Gameobject.CheckLootRefs();
-    SendGlobalSysMessage("DB table `gameobject_loot_template` reloaded.");
+    ReloadLootTemplates("gameobject_loot_template", &LoadLootTemplates_Gameobject);
+    SendSysMessage("DB table `gameobject_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesItemCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`item_loot_template`)");
-    LoadLootTemplates_Item();
-    LootTemplates_Item.CheckLootRefs();
-    SendGlobalSysMessage("DB table `item_loot_template` reloaded.");
+    ReloadLootTemplates("item_loot_template", &LoadLootTemplates_Item);
+    SendSysMessage("DB table `item_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesPickpocketingCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`pickpocketing_loot_template`)");
-    LoadLootTemplates_Pickpocketing();
-    LootTemplates_Pickpocketing.CheckLootRefs();
-    SendGlobalSysMessage("DB table `pickpocketing_loot_template` reloaded.");
+    ReloadLootTemplates("pickpocketing_loot_template", &LoadLootTemplates_Pickpocketing);
+    SendSysMessage("DB table `pickpocketing_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesMailCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`mail_loot_template`)");
-    LoadLootTemplates_Mail();
-    LootTemplates_Mail.CheckLootRefs();
-    SendGlobalSysMessage("DB table `mail_loot_template` reloaded.");
+    ReloadLootTemplates("mail_loot_template", &LoadLootTemplates_Mail);
+    SendSysMessage("DB table `mail_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesReferenceCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`reference_loot_template`)");
-    LoadLootTemplates_Reference();
-    SendGlobalSysMessage("DB table `reference_loot_template` reloaded.");
+    ReloadLootTemplates("reference_loot_template", &LoadLootTemplates_Reference);
+    SendSysMessage("DB table `reference_loot_template` reload started.");
     return true;
 }
 
 bool ChatHandler::HandleReloadLootTemplatesSkinningCommand(char* /*args*/)
 {
-    sLog.outString("Re-Loading Loot Tables... (`skinning_loot_template`)");
-    LoadLootTemplates_Skinning();
-    LootTemplates_Skinning.CheckLootRefs();
-    SendGlobalSysMessage("DB table `skinning_loot_template` reloaded.");
+    ReloadLootTemplates("skinning_loot_template", &LoadLootTemplates_Skinning);
+    SendSysMessage("DB table `skinning_loot_template` reload started.");
     return true;
 }
 
@@ -1150,6 +1141,7 @@ bool ChatHandler::HandleAccountSetGmLevelCommand(char* args)
 
     PSendSysMessage(LANG_YOU_CHANGE_SECURITY, targetAccountName.c_str(), gm);
     LoginDatabase.PExecute("UPDATE account SET gmlevel = '%i' WHERE id = '%u'", gm, targetAccountId);
+    sAccountMgr.UpdateCredentialsVersion();
 
     return true;
 }
@@ -4079,6 +4071,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, ObjectGuid player_guid, u
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, player_guid.GetCounter());
+        sWorld.InvalidateCharEnum(sObjectMgr.GetPlayerAccountIdByGUID(player_guid));
     }
 }
 
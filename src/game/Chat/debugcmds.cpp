@@ -1208,6 +1208,10 @@ bool ChatHandler::HandleDebugMaps(char* /*args*/)
         if (!player)
             return true;
 
+        PSendSysMessage("Current map update arena >> Last: %u bytes, Max: %u bytes",
+            player->GetMap()->GetUpdateArenaBytesLast(), player->GetMap()->GetUpdateArenaBytesMax());
+        PSendSysMessage("Current map creature updates skipped by distance >> Last: %u", player->GetMap()->GetUpdateLodSkippedLast());
+
         if (player->GetMap()->IsContinent())
             return true;
 
@@ -1416,6 +1420,23 @@ bool ChatHandler::HandleDebugLootDropStats(char* args)
     return true;
 }
 
+bool ChatHandler::HandleDebugCorpseLootStats(char* /*args*/)
+{
+    sLootMgr.PrintCorpseLootStats(*this);
+    return true;
+}
+
+bool ChatHandler::HandleDebugCompressionStats(char* /*args*/)
+{
+    uint64 packets, bytesIn, bytesOut, compressTime;
+    UpdateData::GetCompressionStats(packets, bytesIn, bytesOut, compressTime);
+
+    PSendSysMessage("Compressed update packets: " UI64FMTD ", bytes: " UI64FMTD " -> " UI64FMTD " (%.1f%%), compress time: " UI64FMTD " ms (%.1f us per packet)",
+                    packets, bytesIn, bytesOut, bytesIn ? 100.0 * bytesOut / bytesIn : 0.0,
+                    compressTime / IN_MILLISECONDS, packets ? double(compressTime) / packets : 0.0);
+    return true;
+}
+
 bool ChatHandler::HandleDebugSendWorldState(char* args)
 {
     Player* player = m_session->GetPlayer();
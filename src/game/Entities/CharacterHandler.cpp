@@ -201,10 +201,12 @@ bool LoginQueryHolder::Initialize()
 class CharacterHandler
 {
     public:
-        void HandleCharEnumCallback(QueryResult* result, uint32 account)
+        void HandleCharEnumCallback(QueryResult* result, uint32 account, uint32 cacheGeneration)
         {
             if (WorldSession* session = sWorld.FindSession(account))
-                session->HandleCharEnum(result);
+                session->HandleCharEnum(result, cacheGeneration);
+            else
+                delete result;
         }
 
         void HandlePlayerLoginCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
@@ -226,7 +228,7 @@ class CharacterHandler
         }
 } chrHandler;
 
-void WorldSession::HandleCharEnum(QueryResult* result)
+void WorldSession::HandleCharEnum(QueryResult* result, uint32 cacheGeneration)
 {
     WorldPacket data(SMSG_CHAR_ENUM, 100);                  // we guess size
 
@@ -250,13 +252,23 @@ void WorldSession::HandleCharEnum(QueryResult* result)
 
     data.put<uint8>(0, num);
 
+    sWorld.CacheCharEnum(GetAccountId(), data, cacheGeneration);
+
     SendPacket(data, true);
 }
 
 void WorldSession::HandleCharEnumOpcode(WorldPacket& /*recv_data*/)
 {
+    /// character list is kept until characters of the account are changed
+    WorldPacket data;
+    if (sWorld.GetCachedCharEnum(GetAccountId(), data))
+    {
+        SendPacket(data, true);
+        return;
+    }
+
     /// get all the data necessary for loading all characters (along with their pets) on the account
-    CharacterDatabase.AsyncPQuery(&chrHandler, &CharacterHandler::HandleCharEnumCallback, GetAccountId(),
+    CharacterDatabase.AsyncPQuery(&chrHandler, &CharacterHandler::HandleCharEnumCallback, GetAccountId(), sWorld.GetCharEnumGeneration(),
                                   //           0               1                2                3                 4                  5                       6                        7
                                   "SELECT characters.guid, characters.name, characters.race, characters.class, characters.gender, characters.playerBytes, characters.playerBytes2, characters.level, "
                                   //   8                9               10                     11                     12                     13                    14
@@ -446,6 +458,7 @@ void WorldSession::HandleCharCreateOpcode(WorldPacket& recv_data)
 
     // Player created, save it now
     pNewChar->SaveToDB();
+    sWorld.InvalidateCharEnum(GetAccountId());
     charcount += 1;
 
     LoginDatabase.PExecute("DELETE FROM realmcharacters WHERE acctid= '%u' AND realmid = '%u'", GetAccountId(), realmID);
@@ -1066,6 +1079,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uin
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
     CharacterDatabase.CommitTransaction();
+    sWorld.InvalidateCharEnum(accountId);
 
     sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", session->GetAccountId(), session->GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
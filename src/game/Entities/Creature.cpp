@@ -141,7 +141,8 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_originalEntry(0), m_ai(nullptr),
     m_isInvisible(false), m_ignoreMMAP(false), m_forceAttackingCapability(false), m_ignoreRangedTargets(false), m_countSpawns(false),
     m_creatureInfo(nullptr),
-    m_noXP(false), m_noLoot(false), m_noReputation(false)
+    m_noXP(false), m_noLoot(false), m_noReputation(false),
+    m_lodPendingDiff(0)
 {
     m_regenTimer = 200;
     m_valuesCount = UNIT_END;
@@ -577,6 +578,19 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
     return display_id;
 }
 
+bool Creature::TakeLodUpdateDiff(uint32 diff, uint32 interval, uint32 tick, uint32& updateDiff)
+{
+    m_lodPendingDiff += diff;
+
+    // creatures of same ring are spread over ticks of interval
+    if (interval > 1 && (tick + GetGUIDLow()) % interval)
+        return false;
+
+    updateDiff = m_lodPendingDiff;
+    m_lodPendingDiff = 0;
+    return true;
+}
+
 void Creature::Update(const uint32 diff)
 {
     switch (m_deathState)
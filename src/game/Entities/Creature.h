@@ -572,6 +572,8 @@ class Creature : public Unit
         char const* GetSubName() const { return GetCreatureInfo()->SubName; }
 
         void Update(const uint32 diff) override;  // overwrite Unit::Update
+        // skipped map update diffs are accumulated, false if creature is not updated in this map tick
+        bool TakeLodUpdateDiff(uint32 diff, uint32 interval, uint32 tick, uint32& updateDiff);
 
         virtual void RegenerateAll(uint32 update_diff);
         uint32 GetEquipmentId() const { return m_equipmentId; }
@@ -900,6 +902,8 @@ class Creature : public Unit
     private:
         GridReference<Creature> m_gridRef;
         CreatureInfo const* m_creatureInfo;
+
+        uint32 m_lodPendingDiff;                            // diff of skipped map updates
 };
 
 class ForcedDespawnDelayEvent : public BasicEvent
@@ -299,12 +299,8 @@ void Item::SaveToDB()
             SqlStatement stmt = CharacterDatabase.CreateStatement(delItem, "DELETE FROM item_instance WHERE guid = ?");
             stmt.PExecute(guid);
 
-            std::ostringstream ss;
-            for (uint16 i = 0; i < m_valuesCount; ++i)
-                ss << GetUInt32Value(i) << " ";
-
             stmt = CharacterDatabase.CreateStatement(insItem, "INSERT INTO item_instance (guid,owner_guid,data) VALUES (?, ?, ?)");
-            stmt.PExecute(guid, GetOwnerGuid().GetCounter(), ss.str().c_str());
+            stmt.PExecute(guid, GetOwnerGuid().GetCounter(), SaveValues().c_str());
         } break;
         case ITEM_CHANGED:
         {
@@ -312,12 +308,7 @@ void Item::SaveToDB()
             static SqlStatementID updGifts ;
 
             SqlStatement stmt = CharacterDatabase.CreateStatement(updInstance, "UPDATE item_instance SET data = ?, owner_guid = ? WHERE guid = ?");
-
-            std::ostringstream ss;
-            for (uint16 i = 0; i < m_valuesCount; ++i)
-                ss << GetUInt32Value(i) << " ";
-
-            stmt.PExecute(ss.str().c_str(), GetOwnerGuid().GetCounter(), guid);
+            stmt.PExecute(SaveValues().c_str(), GetOwnerGuid().GetCounter(), guid);
 
             if (HasFlag(ITEM_FIELD_FLAGS, ITEM_DYNFLAG_WRAPPED))
             {
@@ -421,6 +412,10 @@ bool Item::LoadFromDB(uint32 guidLow, Field* fields, ObjectGuid ownerGuid)
 
     bool need_save = false;                                 // need explicit save data at load fixes
 
+    // rewrite rows still in space separated text format
+    if (IsLegacyValuesFormat(fields[0].GetString()))
+        need_save = true;
+
     // overwrite possible wrong/corrupted guid
     ObjectGuid new_item_guid = ObjectGuid(HIGHGUID_ITEM, guidLow);
     if (GetGuidValue(OBJECT_FIELD_GUID) != new_item_guid)
@@ -486,12 +481,7 @@ bool Item::LoadFromDB(uint32 guidLow, Field* fields, ObjectGuid ownerGuid)
         static SqlStatementID updItem ;
 
         SqlStatement stmt = CharacterDatabase.CreateStatement(updItem, "UPDATE item_instance SET data = ?, owner_guid = ? WHERE guid = ?");
-
-        std::ostringstream ss;
-        for (uint16 i = 0; i < m_valuesCount; ++i)
-            ss << GetUInt32Value(i) << " ";
-
-        stmt.addString(ss);
+        stmt.addString(SaveValues());
         stmt.addUInt32(GetOwnerGuid().GetCounter());
         stmt.addUInt32(guidLow);
         stmt.Execute();
@@ -29,6 +29,7 @@
 #include "Entities/UpdateData.h"
 #include "Entities/UpdateMask.h"
 #include "Util.h"
+#include "TSS.h"
 #include "Maps/MapManager.h"
 #include "Grids/CellImpl.h"
 #include "Grids/GridNotifiers.h"
@@ -51,6 +52,9 @@ constexpr float VisibilityDistances[AsUnderlyingType(VisibilityDistanceType::Max
     MAX_VISIBILITY_DISTANCE
 };
 
+// mask buffer reused by update block building of each thread
+static MaNGOS::thread_local_ptr<UpdateMask> threadUpdateMask;
+
 Object::Object(): m_updateFlag(0), m_itsNewObject(false)
 {
     m_objectTypeId      = TYPEID_OBJECT;
@@ -89,7 +93,7 @@ void Object::_InitValues()
     m_uint32Values = new uint32[ m_valuesCount ];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    m_changedValues.resize(m_valuesCount, false);
+    m_changedValues.SetCount(m_valuesCount);
 
     m_objectUpdated = false;
 }
@@ -180,10 +184,10 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) c
     buf << uint8(m_objectTypeId);
 
     BuildMovementUpdate(&buf, updateFlags);
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
-    _SetCreateBits(&updateMask, target);
-    BuildValuesUpdate(updatetype, &buf, &updateMask, target);
+    UpdateMask* updateMask = threadUpdateMask.get();
+    updateMask->SetCount(m_valuesCount);
+    _SetCreateBits(updateMask, target);
+    BuildValuesUpdate(updatetype, &buf, updateMask, target);
     data->AddUpdateBlock(buf);
 }
 
@@ -207,11 +211,11 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
+    UpdateMask* updateMask = threadUpdateMask.get();
+    updateMask->SetCount(m_valuesCount);
 
-    _SetUpdateBits(&updateMask, target);
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    _SetUpdateBits(updateMask, target);
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, updateMask, target);
 
     data->AddUpdateBlock(buf);
 }
@@ -223,11 +227,11 @@ void Object::BuildForcedValuesUpdateBlockForPlayer(UpdateData* data, Player* tar
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
+    UpdateMask* updateMask = threadUpdateMask.get();
+    updateMask->SetCount(m_valuesCount);
 
-    _SetCreateBits(&updateMask, target);
-    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    _SetCreateBits(updateMask, target);
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, updateMask, target);
 
     data->AddUpdateBlock(buf);
 }
@@ -361,263 +365,255 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
 
     *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+    for (uint32 block = 0; block < updateMask->GetBlockCount(); ++block)
+        *data << updateMask->GetBlock(block);
 
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < m_valuesCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == UNIT_NPC_FLAGS)
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+                uint32 appendValue = m_uint32Values[index];
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                if (GetTypeId() == TYPEID_UNIT)
+                {
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                        }
+                        if (!((Creature*)this)->IsTrainerOf(target, false))
+                            appendValue &= ~UNIT_NPC_FLAG_TRAINER;
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+                    {
+                        if (target->getClass() != CLASS_HUNTER)
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    {
+                        QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                         {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanSeeStartQuest(pQuest))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
+                        }
 
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        {
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanRewardQuest(pQuest, false))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
                         }
                     }
-
-                    *data << uint32(appendValue);
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
-                else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
-                {
-                    uint32 value = m_uint32Values[index];
+                *data << uint32(appendValue);
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
 
-                    // Fog of War: replace absolute health values with percentages for non-allied units according to settings
-                    if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target))
-                    {
-                        switch (index)
-                        {
-                            case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
-                            case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
-                        }
-                    }
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
+                     (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
+            else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+            {
+                uint32 value = m_uint32Values[index];
 
-                    *data << value;
-                }
-                // Fog of War: hide stat values for non-allied units according to settings
-                else if ((index == UNIT_FIELD_RANGEDATTACKTIME ||
-                          index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
-                          index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
-                          (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
-                          index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
-                          index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
-                          index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
-                          index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_POWER_COST_MULTIPLIER_06)) &&
-                          !static_cast<const Unit*>(this)->IsFogOfWarVisibleStats(target))
+                // Fog of War: replace absolute health values with percentages for non-allied units according to settings
+                if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target))
                 {
-                    *data << uint32(0);
+                    switch (index)
+                    {
+                        case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
+                        case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
+                    }
                 }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+                *data << value;
+            }
+            // Fog of War: hide stat values for non-allied units according to settings
+            else if ((index == UNIT_FIELD_RANGEDATTACKTIME ||
+                      index == UNIT_FIELD_MINDAMAGE || index == UNIT_FIELD_MAXDAMAGE ||
+                      index == UNIT_FIELD_MINOFFHANDDAMAGE || index == UNIT_FIELD_MAXOFFHANDDAMAGE ||
+                      (index >= UNIT_FIELD_STAT0 && index < UNIT_FIELD_BASE_MANA) ||
+                      index == UNIT_FIELD_BASE_HEALTH || index == UNIT_FIELD_ATTACK_POWER ||
+                      index == UNIT_FIELD_ATTACK_POWER_MODS || index == UNIT_FIELD_ATTACK_POWER_MULTIPLIER ||
+                      index == UNIT_FIELD_RANGED_ATTACK_POWER || index == UNIT_FIELD_RANGED_ATTACK_POWER_MODS ||
+                      index == UNIT_FIELD_RANGED_ATTACK_POWER_MULTIPLIER || index == UNIT_FIELD_MINRANGEDDAMAGE ||
+                      index == UNIT_FIELD_MAXRANGEDDAMAGE || (index >= UNIT_FIELD_POWER_COST_MODIFIER && index <= UNIT_FIELD_POWER_COST_MULTIPLIER_06)) &&
+                      !static_cast<const Unit*>(this)->IsFogOfWarVisibleStats(target))
+            {
+                *data << uint32(0);
+            }
+
+            // Gamemasters should be always able to select units - remove not selectable flag
+            else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+            {
+                *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
+            }
+            // Hide lootable animation for unallowed players
+            // Handle tapped flag
+            else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+            {
+                Creature* creature = (Creature*)this;
+                uint32 dynflagsValue = m_uint32Values[index];
+                bool setTapFlags = false;
+
+                if (creature->isAlive())
                 {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
+                    // creature is alive so, not lootable
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+
+                    if (creature->isInCombat())
+                    {
+                        // as creature is in combat we have to manage tap flags
+                        setTapFlags = true;
+                    }
+                    else
+                    {
+                        // creature is not in combat so its not tapped
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                    }
                 }
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+                else
                 {
-                    Creature* creature = (Creature*)this;
-                    uint32 dynflagsValue = m_uint32Values[index];
-                    bool setTapFlags = false;
-
-                    if (creature->isAlive())
+                    // check loot flag
+                    if (creature->loot && creature->loot->CanLoot(target))
                     {
-                        // creature is alive so, not lootable
-                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-
-                        if (creature->isInCombat())
-                        {
-                            // as creature is in combat we have to manage tap flags
-                            setTapFlags = true;
-                        }
-                        else
-                        {
-                            // creature is not in combat so its not tapped
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
+                        // creature is dead and this player can loot it
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
                     else
                     {
-                        // check loot flag
-                        if (creature->loot && creature->loot->CanLoot(target))
-                        {
-                            // creature is dead and this player can loot it
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-                        else
-                        {
-                            // creature is dead but this player cannot loot it
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-
-                        // as creature is died we have to manage tap flags
-                        setTapFlags = true;
+                        // creature is dead but this player cannot loot it
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                        //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
 
-                    // check tap flags
-                    if (setTapFlags)
+                    // as creature is died we have to manage tap flags
+                    setTapFlags = true;
+                }
+
+                // check tap flags
+                if (setTapFlags)
+                {
+                    if (creature->IsTappedBy(target))
                     {
-                        if (creature->IsTappedBy(target))
-                        {
-                            // creature is in combat or died and tapped by this player
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
-                        else
-                        {
-                            // creature is in combat or died but not tapped by this player
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                            //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                        }
+                        // creature is in combat or died and tapped by this player
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
-
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                    else
                     {
-                        Unit* unit = (Unit*)this; // hunters mark effects should only be visible to owners and not all players
-                        if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
-                            dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                        // creature is in combat or died but not tapped by this player
+                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                        //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                     }
+                }
 
-                    *data << dynflagsValue;
+                if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                {
+                    Unit* unit = (Unit*)this; // hunters mark effects should only be visible to owners and not all players
+                    if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
+                        dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
                 }
-                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+
+                *data << dynflagsValue;
+            }
+            else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
+                if (this != target && GetTypeId() == TYPEID_PLAYER && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
                 {
-                    uint32 value = m_uint32Values[index];
+                    Player const* thisPlayer = static_cast<Player const*>(this);
+                    const uint32 targetTeam = target->GetTeam();
 
-                    // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
-                    if (this != target && GetTypeId() == TYPEID_PLAYER && sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+                    if (thisPlayer->GetTeam() != targetTeam && !thisPlayer->HasCharmer() && target->IsInGroup(thisPlayer))
                     {
-                        Player const* thisPlayer = static_cast<Player const*>(this);
-                        const uint32 targetTeam = target->GetTeam();
-
-                        if (thisPlayer->GetTeam() != targetTeam && !thisPlayer->HasCharmer() && target->IsInGroup(thisPlayer))
+                        switch (targetTeam)
                         {
-                            switch (targetTeam)
-                            {
-                                case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
-                                case HORDE:     value = 1495;   break;  // "Horde Generic"
-                            }
+                            case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
+                            case HORDE:     value = 1495;   break;  // "Horde Generic"
                         }
                     }
-
-                    *data << value;
-                }
-                else                                        // Unhandled index, just send
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
                 }
+
+                *data << value;
+            }
+            else                                        // Unhandled index, just send
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
             }
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < m_valuesCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYN_FLAGS)
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
+                if (IsActivateToQuest)
                 {
-                    if (IsActivateToQuest)
+                    GameObject const* gameObject = static_cast<GameObject const*>(this);
+                    switch (((GameObject*)this)->GetGoType())
                     {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                        case GAMEOBJECT_TYPE_QUESTGIVER:
+                        case GAMEOBJECT_TYPE_CHEST:
+                            if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
+                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            else
                                 *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
+                            *data << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_GENERIC:
+                        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            *data << uint16(0);
+                            break;
+                        default:
+                            *data << uint32(0);         // unknown, not happen.
+                            break;
                     }
-                    else
-                        *data << uint32(0);                 // disable quest object
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                    *data << uint32(0);                 // disable quest object
             }
+            else
+                *data << m_uint32Values[index];         // other cases
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextBit(0); index < m_valuesCount; index = updateMask->GetNextBit(index + 1))
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[index];
         }
     }
 }
@@ -626,8 +622,7 @@ void Object::ClearUpdateMask(bool remove)
 {
     if (m_uint32Values)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
+        m_changedValues.Clear();
     }
 
     if (m_objectUpdated)
@@ -638,37 +633,108 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
+#define VALUES_FORMAT_HEADER     "#1:"
+#define VALUES_FORMAT_HEADER_LEN 3
+
 bool Object::LoadValues(const char* data)
 {
     if (!m_uint32Values) _InitValues();
 
-    Tokens tokens = StrSplit(data, " ");
+    return DecodeValues(data, m_uint32Values, m_valuesCount) == m_valuesCount;
+}
 
-    if (tokens.size() != m_valuesCount)
-        return false;
+bool Object::IsLegacyValuesFormat(const char* data)
+{
+    return strncmp(data, VALUES_FORMAT_HEADER, VALUES_FORMAT_HEADER_LEN) != 0;
+}
+
+int32 Object::DecodeValues(const char* data, uint32* values, uint16 maxCount)
+{
+    if (!data)
+        return -1;
+
+    if (IsLegacyValuesFormat(data))
+    {
+        uint16 count = 0;
+        for (;;)
+        {
+            while (*data == ' ')
+                ++data;
+            if (!*data)
+                break;
+
+            if (count >= maxCount)
+                return -1;
 
-    Tokens::iterator iter;
-    int index;
-    for (iter = tokens.begin(), index = 0; index < m_valuesCount; ++iter, ++index)
+            char* end;
+            values[count++] = uint32(strtoul(data, &end, 10));
+            if (end == data || (*end && *end != ' '))
+                return -1;
+            data = end;
+        }
+        return count;
+    }
+
+    data += VALUES_FORMAT_HEADER_LEN;
+    size_t length = strlen(data);
+    if (length % 8 || length / 8 > maxCount)
+        return -1;
+
+    uint16 count = uint16(length / 8);
+    for (uint16 i = 0; i < count; ++i)
     {
-        m_uint32Values[index] = std::stoul(*iter);
+        uint32 value = 0;
+        for (int j = 0; j < 8; ++j, ++data)
+        {
+            char c = *data;
+            if (c >= '0' && c <= '9')
+                value = (value << 4) | uint32(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                value = (value << 4) | uint32(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                value = (value << 4) | uint32(c - 'A' + 10);
+            else
+                return -1;
+        }
+        values[i] = value;
     }
+    return count;
+}
 
-    return true;
+std::string Object::EncodeValues(uint32 const* values, uint16 count)
+{
+    static char const hexDigits[] = "0123456789abcdef";
+
+    std::string data(VALUES_FORMAT_HEADER_LEN + size_t(count) * 8, '0');
+    memcpy(&data[0], VALUES_FORMAT_HEADER, VALUES_FORMAT_HEADER_LEN);
+
+    char* out = &data[VALUES_FORMAT_HEADER_LEN];
+    for (uint16 i = 0; i < count; ++i)
+        for (int shift = 28; shift >= 0; shift -= 4)
+            *out++ = hexDigits[(values[i] >> shift) & 0xF];
+
+    return data;
 }
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index])
-            updateMask->SetBit(index);
+    *updateMask |= m_changedValues;
 }
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (GetUInt32Value(index) != 0)
-            updateMask->SetBit(index);
+    // build whole blocks, mask is only written once per 32 fields
+    for (uint32 block = 0; block < updateMask->GetBlockCount(); ++block)
+    {
+        uint32 bits = 0;
+        uint32 first = block << 5;
+        uint32 last = std::min(first + 32, uint32(m_valuesCount));
+        for (uint32 index = first; index < last; ++index)
+            if (m_uint32Values[index] != 0)
+                bits |= 1u << (index - first);
+
+        updateMask->SetBlock(block, updateMask->GetBlock(block) | bits);
+    }
 }
 
 void Object::SetInt32Value(uint16 index, int32 value)
@@ -678,7 +744,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -690,7 +756,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -702,8 +768,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        m_changedValues.SetBit(index);
+        m_changedValues.SetBit(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -715,7 +781,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -734,7 +800,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -753,7 +819,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -815,7 +881,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -829,7 +895,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -847,7 +913,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -865,7 +931,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -877,7 +943,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -889,7 +955,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        m_changedValues.SetBit(index);
         MarkForClientUpdate();
     }
 }
@@ -957,7 +1023,7 @@ void Object::MarkForClientUpdate()
 
 void Object::ForceValuesUpdateAtIndex(uint16 index)
 {
-    m_changedValues[index] = true;
+    m_changedValues.SetBit(index);
     if (m_inWorld && !m_objectUpdated)
     {
         AddToClientUpdateList();
@@ -23,6 +23,7 @@
 #include "ByteBuffer.h"
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
+#include "Entities/UpdateMask.h"
 #include "Entities/ObjectGuid.h"
 #include "Entities/EntitiesMgr.h"
 #include "Globals/SharedDefines.h"
@@ -136,7 +137,6 @@ class Player;
 class Unit;
 class Group;
 class Map;
-class UpdateMask;
 class InstanceData;
 class TerrainInfo;
 struct MangosStringLocale;
@@ -145,7 +145,8 @@ struct ItemPrototype;
 class ChatHandler;
 struct SpellEntry;
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+// per tick temporary only, nodes are taken from frame arena in map update
+typedef std::unordered_map<Player*, UpdateData, std::hash<Player*>, std::equal_to<Player*>, FrameArenaAllocator<std::pair<Player* const, UpdateData> > > UpdateDataMapType;
 
 class CooldownData
 {
@@ -587,6 +588,13 @@ class Object
         void ClearUpdateMask(bool remove);
 
         bool LoadValues(const char* data);
+        std::string SaveValues() const { return EncodeValues(m_uint32Values, m_valuesCount); }
+
+        // stored values are "#1:" followed by 8 hex digits per field, older rows hold space separated decimal numbers
+        // decoded field count is returned, -1 for broken data or more than maxCount fields
+        static int32 DecodeValues(const char* data, uint32* values, uint16 maxCount);
+        static std::string EncodeValues(uint32 const* values, uint16 count);
+        static bool IsLegacyValuesFormat(const char* data);
 
         uint16 GetValuesCount() const { return m_valuesCount; }
 
@@ -628,7 +636,7 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        UpdateMask m_changedValues;                         // fields changed since last client update
 
         uint16 m_valuesCount;
 
@@ -3696,11 +3696,8 @@ void Player::_SetCreateBits(UpdateMask* updateMask, Player* target) const
     }
     else
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (GetUInt32Value(index) != 0 && updateVisualBits.GetBit(index))
-                updateMask->SetBit(index);
-        }
+        Object::_SetCreateBits(updateMask, target);
+        *updateMask &= updateVisualBits;
     }
 }
 
@@ -4163,6 +4160,8 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             sLog.outError("Player::DeleteFromDB: Unsupported delete method: %u.", charDelete_method);
     }
 
+    sWorld.InvalidateCharEnum(accountId);
+
     if (updateRealmChars)
         sWorld.UpdateRealmCharCount(accountId);
 }
@@ -13710,6 +13709,7 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
         delete result;
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid ='%u'",
                                    uint32(AT_LOGIN_RENAME), guid.GetCounter());
+        sWorld.InvalidateCharEnum(GetSession()->GetAccountId());
         return false;
     }
 
@@ -15891,6 +15891,7 @@ void Player::SavePositionInDB(ObjectGuid guid, uint32 mapid, float x, float y, f
        << "transguid='0',taxi_path='' WHERE guid='" << guid.GetCounter() << "'";
     DEBUG_LOG("%s", ss.str().c_str());
     CharacterDatabase.Execute(ss.str().c_str());
+    sWorld.InvalidateCharEnum(sObjectMgr.GetPlayerAccountIdByGUID(guid));
 }
 
 void Player::SetUInt32ValueInArray(Tokens& tokens, uint16 index, uint32 value)
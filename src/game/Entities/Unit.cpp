@@ -329,6 +329,7 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_procAuraHolderFlags = 0;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -4369,6 +4370,13 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
         holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
 
+    // index holders which can proc, only those are checked in ProcDamageAndSpellFor
+    if (uint32 procFlags = sSpellMgr.GetSpellProcFlags(holder->GetSpellProto()))
+    {
+        m_procAuraHolders.insert(ProcAuraHolderMap::value_type(holder->GetId(), ProcAuraHolderMap::mapped_type(holder, procFlags)));
+        m_procAuraHolderFlags |= procFlags;
+    }
+
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
             AddAuraToModList(aur);
@@ -4847,6 +4855,20 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         }
     }
 
+    std::pair<ProcAuraHolderMap::iterator, ProcAuraHolderMap::iterator> procBounds = m_procAuraHolders.equal_range(holder->GetId());
+    for (ProcAuraHolderMap::iterator itr = procBounds.first; itr != procBounds.second; ++itr)
+    {
+        if (itr->second.first == holder)
+        {
+            m_procAuraHolders.erase(itr);
+
+            m_procAuraHolderFlags = 0;
+            for (ProcAuraHolderMap::const_iterator procItr = m_procAuraHolders.begin(); procItr != m_procAuraHolders.end(); ++procItr)
+                m_procAuraHolderFlags |= procItr->second.second;
+            break;
+        }
+    }
+
     holder->SetRemoveMode(mode);
     holder->UnregisterAndCleanupTrackedAuras();
 
@@ -10282,11 +10304,7 @@ void Unit::ScheduleAINotify(uint32 delay, bool forced)
         m_events.AddEvent(m_AINotifyEvent, m_events.CalculateTime(delay));
     }
     else if (forced)
-    {
-        m_events.KillEvent(m_AINotifyEvent);
-        m_AINotifyEvent = new UnitVisitObjectsInRangeNotifyEvent(*this);
-        m_events.AddEvent(m_AINotifyEvent, m_events.CalculateTime(delay));
-    }
+        m_events.RescheduleEvent(m_AINotifyEvent, m_events.CalculateTime(delay));
 }
 
 void Unit::AbortAINotifyEvent()
@@ -10995,11 +11013,13 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
-                if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
+        target->m_events.VisitEvents([this](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
+                if (event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
                         event->GetSpell()->cancel();
+        });
     }
 }
 
@@ -2387,6 +2387,9 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        typedef std::multimap<uint32 /*spellId*/, std::pair<SpellAuraHolder*, uint32 /*procFlags*/> > ProcAuraHolderMap;
+        ProcAuraHolderMap m_procAuraHolders;                // holders which can proc, in m_spellAuraHolders order
+        uint32 m_procAuraHolderFlags;                       // proc flags of all m_procAuraHolders
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
 
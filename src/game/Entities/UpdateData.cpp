@@ -17,6 +17,8 @@
  */
 
 #include <zlib.h>
+#include <atomic>
+#include <chrono>
 
 #include "Common.h"
 #include "Entities/UpdateData.h"
@@ -26,6 +28,36 @@
 #include "Server/Opcodes.h"
 #include "World/World.h"
 #include "Entities/ObjectGuid.h"
+#include "TSS.h"
+
+// deflate state is kept per thread and reset for each packet, allocated and set up once
+struct UpdateCompressionStream
+{
+    UpdateCompressionStream() : initialized(false), level(0), strategy(0)
+    {
+        stream.zalloc = (alloc_func)nullptr;
+        stream.zfree = (free_func)nullptr;
+        stream.opaque = (voidpf)nullptr;
+    }
+    ~UpdateCompressionStream()
+    {
+        if (initialized)
+            deflateEnd(&stream);
+    }
+
+    z_stream stream;
+    bool initialized;
+    int level;
+    int strategy;
+};
+
+static MaNGOS::thread_local_ptr<UpdateCompressionStream> compressionStream;
+
+// updated from map threads
+static std::atomic<uint64> compressedPackets(0);
+static std::atomic<uint64> compressedBytesIn(0);
+static std::atomic<uint64> compressedBytesOut(0);
+static std::atomic<uint64> compressTimeMicroseconds(0);
 
 UpdateData::UpdateData() : m_data(1), m_currentIndex(0)
 {
@@ -60,41 +92,55 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
 
 void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
 {
-    z_stream c_stream;
+    auto startTime = std::chrono::steady_clock::now();
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+    UpdateCompressionStream* cs = compressionStream.get();
+    z_stream& c_stream = cs->stream;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    int level = sWorld.getConfig(CONFIG_UINT32_COMPRESSION);
+    int strategy = sWorld.getConfig(CONFIG_UINT32_COMPRESSION_STRATEGY);
+
+    int z_res;
+    if (cs->initialized && (cs->level != level || cs->strategy != strategy))
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        // changed at config reload
+        deflateEnd(&c_stream);
+        cs->initialized = false;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
-
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
+    if (!cs->initialized)
     {
-        sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        z_res = deflateInit2(&c_stream, level, Z_DEFLATED, MAX_WBITS, 8, strategy);
+        if (z_res != Z_OK)
+        {
+            sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+            *dst_size = 0;
+            return;
+        }
+        cs->initialized = true;
+        cs->level = level;
+        cs->strategy = strategy;
     }
-
-    if (c_stream.avail_in != 0)
+    else
     {
-        sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
+        z_res = deflateReset(&c_stream);
+        if (z_res != Z_OK)
+        {
+            sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+            deflateEnd(&c_stream);
+            cs->initialized = false;
+            *dst_size = 0;
+            return;
+        }
     }
 
+    c_stream.next_out = (Bytef*)dst;
+    c_stream.avail_out = *dst_size;
+    c_stream.next_in = (Bytef*)src;
+    c_stream.avail_in = (uInt)src_size;
+
+    // destination is compressBound sized, so all fits in one call
     z_res = deflate(&c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
@@ -103,15 +149,20 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
+
+    ++compressedPackets;
+    compressedBytesIn += src_size;
+    compressedBytesOut += *dst_size;
+    compressTimeMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void UpdateData::GetCompressionStats(uint64& packets, uint64& bytesIn, uint64& bytesOut, uint64& compressTime)
+{
+    packets = compressedPackets;
+    bytesIn = compressedBytesIn;
+    bytesOut = compressedBytesOut;
+    compressTime = compressTimeMicroseconds;
 }
 
 WorldPacket UpdateData::BuildPacket(size_t index, bool hasTransport)
@@ -137,7 +188,7 @@ WorldPacket UpdateData::BuildPacket(size_t index, bool hasTransport)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                        // compress large packets
+    if (pSize > sWorld.getConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD))   // compress large packets
     {
         uint32 destsize = compressBound(pSize);
         packet.resize(destsize + sizeof(uint32));
@@ -68,6 +68,9 @@ class UpdateData
 
         GuidSet const& GetOutOfRangeGUIDs() const { return m_outOfRangeGUIDs; }
 
+        // compressed packet counters since server start, times in microseconds
+        static void GetCompressionStats(uint64& packets, uint64& bytesIn, uint64& bytesOut, uint64& compressTime);
+
     protected:
         GuidSet m_outOfRangeGUIDs;
         std::vector<BufferPair> m_data;
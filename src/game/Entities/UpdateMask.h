@@ -21,11 +21,16 @@
 
 #include "Errors.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// bits are kept in 32 bit blocks, block layout is the one of update mask in client update packets
 class UpdateMask
 {
     public:
-        UpdateMask() : mCount(0), mBlocks(0), mUpdateMask(nullptr) { }
-        UpdateMask(const UpdateMask& mask) : mUpdateMask(nullptr) { *this = mask; }
+        UpdateMask() : mCount(0), mBlocks(0), mCapacity(0), mUpdateMask(nullptr) { }
+        UpdateMask(const UpdateMask& mask) : mCount(0), mBlocks(0), mCapacity(0), mUpdateMask(nullptr) { *this = mask; }
 
         ~UpdateMask()
         {
@@ -34,17 +39,38 @@ class UpdateMask
 
         void SetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] |= 1 << (index & 0x7);
+            mUpdateMask[index >> 5] |= 1u << (index & 0x1F);
         }
 
         void UnsetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] &= (0xff ^ (1 << (index & 0x7)));
+            mUpdateMask[index >> 5] &= ~(1u << (index & 0x1F));
         }
 
         bool GetBit(uint32 index) const
         {
-            return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
+            return (mUpdateMask[index >> 5] & (1u << (index & 0x1F))) != 0;
+        }
+
+        uint32 GetBlock(uint32 block) const { return mUpdateMask[block]; }
+        void SetBlock(uint32 block, uint32 bits) { mUpdateMask[block] = bits; }
+
+        // index of first set bit at or after index, GetCount() if there is none
+        uint32 GetNextBit(uint32 index) const
+        {
+            uint32 block = index >> 5;
+            if (block >= mBlocks)
+                return mCount;
+
+            uint32 bits = mUpdateMask[block] & (~0u << (index & 0x1F));
+            while (!bits)
+            {
+                if (++block >= mBlocks)
+                    return mCount;
+                bits = mUpdateMask[block];
+            }
+
+            return (block << 5) + CountTrailingZeros(bits);
         }
 
         uint32 GetBlockCount() const { return mBlocks; }
@@ -52,14 +78,19 @@ class UpdateMask
         uint32 GetCount() const { return mCount; }
         uint8* GetMask() const { return (uint8*)mUpdateMask; }
 
+        // buffer is kept when large enough, so reused masks don't allocate
         void SetCount(uint32 valuesCount)
         {
-            delete[] mUpdateMask;
-
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
 
-            mUpdateMask = new uint32[mBlocks];
+            if (mBlocks > mCapacity)
+            {
+                delete[] mUpdateMask;
+                mCapacity = mBlocks;
+                mUpdateMask = new uint32[mCapacity];
+            }
+
             memset(mUpdateMask, 0, mBlocks << 2);
         }
 
@@ -71,6 +102,9 @@ class UpdateMask
 
         UpdateMask& operator = (const UpdateMask& mask)
         {
+            if (this == &mask)
+                return *this;
+
             SetCount(mask.mCount);
             memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
 
@@ -80,14 +114,16 @@ class UpdateMask
         void operator &= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
+            for (uint32 i = 0; i < mask.mBlocks; ++i)
                 mUpdateMask[i] &= mask.mUpdateMask[i];
+            for (uint32 i = mask.mBlocks; i < mBlocks; ++i)
+                mUpdateMask[i] = 0;
         }
 
         void operator |= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
-            for (uint32 i = 0; i < mBlocks; ++i)
+            for (uint32 i = 0; i < mask.mBlocks; ++i)
                 mUpdateMask[i] |= mask.mUpdateMask[i];
         }
 
@@ -112,8 +148,20 @@ class UpdateMask
         }
 
     private:
+        static uint32 CountTrailingZeros(uint32 bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return __builtin_ctz(bits);
+#endif
+        }
+
         uint32 mCount;
         uint32 mBlocks;
+        uint32 mCapacity;
         uint32* mUpdateMask;
 };
 #endif
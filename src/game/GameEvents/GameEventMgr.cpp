@@ -733,9 +733,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
                 }
             }
 
-            sObjectMgr.AddCreatureToGrid(itr, data);
-
-            Creature::SpawnInMaps(itr, data);
+            QueueSpawnAction(SPAWN_QUEUE_CREATURE_SPAWN, itr);
         }
     }
 
@@ -763,9 +761,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
                 }
             }
 
-            sObjectMgr.AddGameobjectToGrid(itr, data);
-
-            GameObject::SpawnInMaps(itr, data);
+            QueueSpawnAction(SPAWN_QUEUE_GAMEOBJECT_SPAWN, itr);
         }
     }
 
@@ -778,7 +774,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         }
 
         for (uint16& itr : mGameEventSpawnPoolIds[event_id])
-        sPoolMgr.SpawnPoolInMaps(itr, true);
+            QueueSpawnAction(SPAWN_QUEUE_POOL_SPAWN, itr);
     }
 }
 
@@ -808,11 +804,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
                 }
             }
 
-            // Remove spawn data
-            sObjectMgr.RemoveCreatureFromGrid(itr, data);
-
-            // Remove spawned cases
-            Creature::AddToRemoveListInMaps(itr, data);
+            QueueSpawnAction(SPAWN_QUEUE_CREATURE_DESPAWN, itr);
         }
     }
 
@@ -838,11 +830,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
                 }
             }
 
-            // Remove spawn data
-            sObjectMgr.RemoveGameobjectFromGrid(itr, data);
-
-            // Remove spawned cases
-            GameObject::AddToRemoveListInMaps(itr, data);
+            QueueSpawnAction(SPAWN_QUEUE_GAMEOBJECT_DESPAWN, itr);
         }
     }
 
@@ -856,7 +844,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
 
         for (uint16& itr : mGameEventSpawnPoolIds[event_id])
         {
-            sPoolMgr.DespawnPoolInMaps(itr);
+            QueueSpawnAction(SPAWN_QUEUE_POOL_DESPAWN, itr);
         }
     }
 }
@@ -999,6 +987,177 @@ int16 GameEventMgr::GetGameEventId<Pool>(uint32 guid_or_poolid)
 GameEventMgr::GameEventMgr()
 {
     m_IsGameEventsInit = false;
+    m_spawnQueueSequence = 0;
+}
+
+struct SpawnGridStateWorker
+{
+    SpawnGridStateWorker(float x, float y) : i_x(x), i_y(y), i_loaded(false), i_active(false) {}
+
+    void operator()(Map* map)
+    {
+        if (!map->IsLoaded(i_x, i_y))
+            return;
+
+        i_loaded = true;
+        if (map->IsActiveGrid(i_x, i_y))
+            i_active = true;
+    }
+
+    float i_x, i_y;
+    bool i_loaded;
+    bool i_active;
+};
+
+// return queue index of action, or -1 if it affects only spawn data and can be applied at once
+int32 GameEventMgr::GetSpawnQueuePriority(SpawnQueueAction action, uint32 id) const
+{
+    uint32 mapId;
+    float x, y;
+    switch (action)
+    {
+        case SPAWN_QUEUE_CREATURE_SPAWN:
+        case SPAWN_QUEUE_CREATURE_DESPAWN:
+        {
+            CreatureData const* data = sObjectMgr.GetCreatureData(id);
+            if (!data)
+                return -1;
+            mapId = data->mapid;
+            x = data->posX;
+            y = data->posY;
+            break;
+        }
+        case SPAWN_QUEUE_GAMEOBJECT_SPAWN:
+        case SPAWN_QUEUE_GAMEOBJECT_DESPAWN:
+        {
+            GameObjectData const* data = sObjectMgr.GetGOData(id);
+            if (!data)
+                return -1;
+            mapId = data->mapid;
+            x = data->posX;
+            y = data->posY;
+            break;
+        }
+        default:                                            // pool objects can be in any grid
+            return 1;
+    }
+
+    SpawnGridStateWorker worker(x, y);
+    sMapMgr.DoForAllMapsWithMapId(mapId, worker);
+    if (!worker.i_loaded)
+        return -1;
+    return worker.i_active ? 0 : 1;
+}
+
+void GameEventMgr::QueueSpawnAction(SpawnQueueAction action, uint32 id)
+{
+    uint64 key = (uint64(action / 2) << 32) | id;
+
+    // keep order of actions for same object, the older one is applied at once
+    PendingSpawnMap::iterator pending = m_pendingSpawns.find(key);
+    if (pending != m_pendingSpawns.end())
+    {
+        SpawnQueueAction pendingAction = pending->second.action;
+        m_pendingSpawns.erase(pending);
+        ApplySpawnAction(pendingAction, id);
+    }
+
+    int32 priority = -1;
+    if (m_IsGameEventsInit && sWorld.getConfig(CONFIG_UINT32_GAME_EVENT_SPAWN_PER_TICK))
+        priority = GetSpawnQueuePriority(action, id);
+
+    if (priority < 0)
+    {
+        ApplySpawnAction(action, id);
+        return;
+    }
+
+    QueuedSpawn spawn;
+    spawn.action = action;
+    spawn.id = id;
+    spawn.sequence = ++m_spawnQueueSequence;
+
+    m_pendingSpawns[key] = spawn;
+    m_spawnQueue[priority].push_back(spawn);
+}
+
+void GameEventMgr::ApplySpawnAction(SpawnQueueAction action, uint32 id)
+{
+    switch (action)
+    {
+        case SPAWN_QUEUE_CREATURE_SPAWN:
+            if (CreatureData const* data = sObjectMgr.GetCreatureData(id))
+            {
+                // Add to correct cell
+                sObjectMgr.AddCreatureToGrid(id, data);
+
+                Creature::SpawnInMaps(id, data);
+            }
+            break;
+        case SPAWN_QUEUE_CREATURE_DESPAWN:
+            if (CreatureData const* data = sObjectMgr.GetCreatureData(id))
+            {
+                // Remove spawn data
+                sObjectMgr.RemoveCreatureFromGrid(id, data);
+
+                // Remove spawned cases
+                Creature::AddToRemoveListInMaps(id, data);
+            }
+            break;
+        case SPAWN_QUEUE_GAMEOBJECT_SPAWN:
+            if (GameObjectData const* data = sObjectMgr.GetGOData(id))
+            {
+                // Add to correct cell
+                sObjectMgr.AddGameobjectToGrid(id, data);
+
+                GameObject::SpawnInMaps(id, data);
+            }
+            break;
+        case SPAWN_QUEUE_GAMEOBJECT_DESPAWN:
+            if (GameObjectData const* data = sObjectMgr.GetGOData(id))
+            {
+                // Remove spawn data
+                sObjectMgr.RemoveGameobjectFromGrid(id, data);
+
+                // Remove spawned cases
+                GameObject::AddToRemoveListInMaps(id, data);
+            }
+            break;
+        case SPAWN_QUEUE_POOL_SPAWN:
+            sPoolMgr.SpawnPoolInMaps(uint16(id), true);
+            break;
+        case SPAWN_QUEUE_POOL_DESPAWN:
+            sPoolMgr.DespawnPoolInMaps(uint16(id));
+            break;
+    }
+}
+
+void GameEventMgr::UpdateSpawnQueue()
+{
+    if (m_pendingSpawns.empty())
+        return;
+
+    uint32 count = sWorld.getConfig(CONFIG_UINT32_GAME_EVENT_SPAWN_PER_TICK);
+    if (!count)                                             // disabled at config reload
+        count = m_pendingSpawns.size();
+
+    for (SpawnQueue& queue : m_spawnQueue)
+    {
+        while (!queue.empty() && count > 0)
+        {
+            QueuedSpawn spawn = queue.front();
+            queue.pop_front();
+
+            // skip outdated, already applied at new action queue for same object
+            PendingSpawnMap::iterator pending = m_pendingSpawns.find((uint64(spawn.action / 2) << 32) | spawn.id);
+            if (pending == m_pendingSpawns.end() || pending->second.sequence != spawn.sequence)
+                continue;
+
+            m_pendingSpawns.erase(pending);
+            ApplySpawnAction(spawn.action, spawn.id);
+            --count;
+        }
+    }
 }
 
 bool GameEventMgr::IsActiveHoliday(HolidayIds id)
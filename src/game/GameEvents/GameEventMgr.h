@@ -81,6 +81,7 @@ class GameEventMgr
         void LoadFromDB();
         void Initialize(MapPersistentState* state);         // called at new MapPersistentState object create
         uint32 Update(ActiveEvents const* activeAtShutdown = nullptr);
+        void UpdateSpawnQueue();                            // called each world tick, applies queued spawns in per tick limit
         bool IsValidEvent(uint16 event_id) const { return event_id < mGameEvent.size() && mGameEvent[event_id].isValid(); }
         bool IsActiveEvent(uint16 event_id) const { return (m_ActiveEvents.find(event_id) != m_ActiveEvents.end()); }
         bool IsActiveHoliday(HolidayIds id);
@@ -96,6 +97,20 @@ class GameEventMgr
         void UnApplyEvent(uint16 event_id);
         void GameEventSpawn(int16 event_id);
         void GameEventUnspawn(int16 event_id);
+
+        // spawns in loaded grids are queued and applied across several ticks
+        enum SpawnQueueAction
+        {
+            SPAWN_QUEUE_CREATURE_SPAWN      = 0,
+            SPAWN_QUEUE_CREATURE_DESPAWN    = 1,
+            SPAWN_QUEUE_GAMEOBJECT_SPAWN    = 2,
+            SPAWN_QUEUE_GAMEOBJECT_DESPAWN  = 3,
+            SPAWN_QUEUE_POOL_SPAWN          = 4,
+            SPAWN_QUEUE_POOL_DESPAWN        = 5,
+        };
+        void QueueSpawnAction(SpawnQueueAction action, uint32 id);
+        void ApplySpawnAction(SpawnQueueAction action, uint32 id);
+        int32 GetSpawnQueuePriority(SpawnQueueAction action, uint32 id) const;
         void UpdateCreatureData(int16 event_id, bool activate);
         void UpdateEventQuests(uint16 event_id, bool Activate);
         void SendEventMails(int16 event_id);
@@ -127,6 +142,19 @@ class GameEventMgr
         GameEventDataMap  mGameEvent;
         ActiveEvents m_ActiveEvents;
         bool m_IsGameEventsInit;
+
+        struct QueuedSpawn
+        {
+            SpawnQueueAction action;
+            uint32 id;
+            uint32 sequence;
+        };
+        typedef std::deque<QueuedSpawn> SpawnQueue;
+        typedef std::unordered_map<uint64, QueuedSpawn> PendingSpawnMap;
+
+        SpawnQueue m_spawnQueue[2];                         // grids with players first
+        PendingSpawnMap m_pendingSpawns;                    // object kind and id to last queued action, others are outdated
+        uint32 m_spawnQueueSequence;
 };
 
 #define sGameEventMgr MaNGOS::Singleton<GameEventMgr>::Instance()
@@ -18,6 +18,7 @@
 
 #include "Globals/ObjectMgr.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Policies/Singleton.h"
 
 #include "Server/SQLStorages.h"
@@ -5047,117 +5048,143 @@ void ObjectMgr::LoadAreatriggerLocales()
 
 // not very fast function but it is called only once a day, or on starting-up
 /// @param serverUp true if the server is already running, false when the server is started
-void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
-{
-    time_t basetime = time(nullptr);
-    DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
-    // delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
-    //                                                     0  1           2      3        4          5         6           7   8       9
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,itemTextId,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
-    if (!result)
-    {
-        BarGoLink bar(1);
-        bar.step();
-        sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
-        sLog.outString();
-        return;                                             // any mails need to be returned or deleted
-    }
+/// Amount of expired mails selected at once, items of the page mails are joined to their rows
+#define OLD_MAILS_PAGE_SIZE 1000
 
-    // std::ostringstream delitems, delmails; // will be here for optimization
-    // bool deletemail = false, deleteitem = false;
-    // delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    // delmails << "DELETE FROM mail WHERE id IN ( "
+//                                        0     1              2         3           4             5            6          7             8
+#define OLD_MAILS_PAGE_QUERY "SELECT m.id, m.messageType, m.sender, m.receiver, m.itemTextId, m.has_items, m.checked, mi.item_guid, mi.item_template " \
+    "FROM (SELECT id FROM mail WHERE expire_time < '" UI64FMTD "' AND id > '%u' ORDER BY id LIMIT %u) page " \
+    "JOIN mail m ON m.id = page.id LEFT JOIN mail_items mi ON mi.mail_id = m.id ORDER BY m.id"
 
-    BarGoLink bar(result->GetRowCount());
-    uint32 count = 0;
+/// Returns or deletes expired mails of one page, returns id of last mail in page or 0 if it was the last page
+static uint32 ReturnOrDeleteOldMailsPage(QueryResult* result, time_t basetime, bool serverUp, uint32& count)
+{
+    uint32 mailsInPage = 0;
+    uint32 lastMailId = 0;
 
-    do
-    {
-        bar.step();
+    CharacterDatabase.BeginTransaction();
 
+    bool hasRow = true;
+    while (hasRow)
+    {
         Field* fields = result->Fetch();
-        Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+        Mail m;
+        m.messageID = fields[0].GetUInt32();
+        m.messageType = fields[1].GetUInt8();
+        m.sender = fields[2].GetUInt32();
+        m.receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+        m.itemTextId = fields[4].GetUInt32();
         bool has_items = fields[5].GetBool();
-        m->expire_time = (time_t)fields[6].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[7].GetUInt32();
-        m->checked = fields[8].GetUInt32();
-        m->mailTemplateId = fields[9].GetInt16();
-
-        Player* pl = nullptr;
-        if (serverUp)
-            pl = GetPlayer(m->receiverGuid);
-        if (pl)
+        m.checked = fields[6].GetUInt32();
+
+        // collect items of the mail, they are in following rows
+        do
         {
-            // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            // his in mailbox and he has already listed his mails )
-            delete m;
-            continue;
+            fields = result->Fetch();
+            if (fields[0].GetUInt32() != m.messageID)
+                break;
+
+            if (!fields[7].IsNULL())
+                m.AddItem(fields[7].GetUInt32(), fields[8].GetUInt32());
         }
-        // delete or return mail:
-        if (has_items)
-        {
-            QueryResult* resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if (resultItems)
-            {
-                do
-                {
-                    Field* fields2 = resultItems->Fetch();
+        while ((hasRow = result->NextRow()));
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+        lastMailId = m.messageID;
+        ++mailsInPage;
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+        // this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
+        // his in mailbox and he has already listed his mails )
+        if (serverUp && sObjectMgr.GetPlayer(m.receiverGuid))
+            continue;
 
-                delete resultItems;
-            }
+        // delete or return mail:
+        if (has_items)
+        {
             // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            if (m.messageType != MAIL_NORMAL || (m.checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
             {
                 // mail open and then not returned
-                for (auto& item : m->items)
+                for (auto& item : m.items)
                     CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", item.item_guid);
             }
             else
             {
                 // mail will be returned:
                 CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
-                                           m->receiverGuid.GetCounter(), m->sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
+                                           m.receiverGuid.GetCounter(), m.sender, (uint64)basetime + 30 * DAY, (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m.messageID);
+                for (MailItemInfoVec::iterator itr2 = m.items.begin(); itr2 != m.items.end(); ++itr2)
                 {
                     // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
+                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m.sender, itr2->item_guid);
+                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m.sender, itr2->item_guid);
                 }
-                delete m;
                 continue;
             }
         }
 
-        if (m->itemTextId)
-            CharacterDatabase.PExecute("DELETE FROM item_text WHERE id = '%u'", m->itemTextId);
+        if (m.itemTextId)
+            CharacterDatabase.PExecute("DELETE FROM item_text WHERE id = '%u'", m.itemTextId);
 
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
+        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m.messageID);
         ++count;
     }
-    while (result->NextRow());
-    delete result;
+
+    CharacterDatabase.CommitTransaction();
+
+    return mailsInPage < OLD_MAILS_PAGE_SIZE ? 0 : lastMailId;
+}
+
+void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
+{
+    time_t basetime = time(nullptr);
+    DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    // pages are selected by async queries and only applied in world thread
+    if (serverUp)
+    {
+        CharacterDatabase.AsyncPQuery(&ObjectMgr::ReturnOrDeleteOldMailsCallback, uint64(basetime), OLD_MAILS_PAGE_QUERY, uint64(basetime), 0, OLD_MAILS_PAGE_SIZE);
+        return;
+    }
+
+    // delete all old mails without item and without body immediately, if starting server
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND itemTextId = 0", (uint64)basetime);
+
+    BarGoLink bar(1);
+    bar.step();
+
+    uint32 count = 0;
+    uint32 lastMailId = 0;
+    do
+    {
+        QueryResult* result = CharacterDatabase.PQuery(OLD_MAILS_PAGE_QUERY, (uint64)basetime, lastMailId, OLD_MAILS_PAGE_SIZE);
+        if (!result)
+            break;
+
+        lastMailId = ReturnOrDeleteOldMailsPage(result, basetime, serverUp, count);
+        delete result;
+    }
+    while (lastMailId);
 
     sLog.outString(">> Loaded %u mails", count);
     sLog.outString();
 }
 
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime)
+{
+    if (!result)
+        return;
+
+    uint32 count = 0;
+    uint32 lastMailId = ReturnOrDeleteOldMailsPage(result, time_t(basetime), true, count);
+    delete result;
+
+    DEBUG_LOG("Returning mails: %u expired mails deleted in page", count);
+
+    // next page is selected after queued changes of this one
+    if (lastMailId)
+        CharacterDatabase.AsyncPQuery(&ObjectMgr::ReturnOrDeleteOldMailsCallback, basetime, OLD_MAILS_PAGE_QUERY, basetime, lastMailId, OLD_MAILS_PAGE_SIZE);
+}
+
 void ObjectMgr::LoadQuestAreaTriggers()
 {
     mQuestAreaTriggerMap.clear();                           // need for reload case
@@ -790,6 +790,7 @@ class ObjectMgr
         void LoadStandingList();
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        static void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime);
 
         void SetHighestGuids();
 
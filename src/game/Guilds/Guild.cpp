@@ -225,6 +225,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 
     CharacterDatabase.PExecute("INSERT INTO guild_member (guildid,guid,`rank`,pnote,offnote) VALUES ('%u', '%u', '%u','%s','%s')",
                                m_Id, lowguid, newmember.RankId, dbPnote.c_str(), dbOFFnote.c_str());
+    sWorld.InvalidateCharEnum(newmember.accountId);
 
     // If player not in game data in data field will be loaded from guild tables, no need to update it!!
     if (pl)
@@ -526,6 +527,11 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
         }
     }
 
+    uint32 accountId = 0;
+    MemberList::const_iterator slot = members.find(lowguid);
+    if (slot != members.end())
+        accountId = slot->second.accountId;
+
     members.erase(lowguid);
 
     Player* player = sObjectMgr.GetPlayer(guid);
@@ -537,6 +543,7 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     CharacterDatabase.PExecute("DELETE FROM guild_member WHERE guid = '%u'", lowguid);
+    sWorld.InvalidateCharEnum(accountId);
 
     if (!isDisbanding)
         UpdateAccountsNumber();
@@ -30,6 +30,7 @@
 #include "Entities/ItemEnchantmentMgr.h"
 #include "Entities/Corpse.h"
 #include "Tools/Language.h"
+#include "World/ReloadMgr.h"
 #include <sstream>
 #include <iomanip>
 
@@ -64,6 +65,7 @@ class LootTemplate::LootGroup                               // A set of loot def
         bool HasQuestDropForPlayer(Player const* player) const;
         // The same for active quests of the player
         void Process(Loot& loot, Player const* lootOwner) const; // Rolls an item from the group (if any) and adds the item to the loot
+        void CollectEntries(std::vector<LootStoreItem const*>& entries) const; // Adds all entries of the group
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
@@ -76,19 +78,48 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const; // Rolls an item from the group, returns nullptr if all miss their chances
 };
 
+LootStore::~LootStore()
+{
+    DeleteTemplates(m_LootTemplates.load());
+    DeleteTemplates(m_loadedTemplates);
+}
+
 // Remove all data and free all memory
-void LootStore::Clear()
+void LootStore::DeleteTemplates(LootTemplateMap* templates)
 {
-    for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+    if (!templates)
+        return;
+
+    for (LootTemplateMap::const_iterator itr = templates->begin(); itr != templates->end(); ++itr)
         delete itr->second;
-    m_LootTemplates.clear();
+    delete templates;
+}
+
+LootTemplateMap const& LootStore::GetTemplates() const
+{
+    if (ReloadMgr::IsReloadThread() && m_loadedTemplates)
+        return *m_loadedTemplates;
+
+    return *m_LootTemplates.load(std::memory_order_acquire);
+}
+
+bool LootStore::ApplyLoadedTemplates()
+{
+    if (!m_loadedTemplates)
+        return false;
+
+    // map updates of current tick may still use replaced templates
+    LootTemplateMap* replaced = m_LootTemplates.exchange(m_loadedTemplates, std::memory_order_acq_rel);
+    m_loadedTemplates = nullptr;
+    sReloadMgr.Retire([replaced]() { DeleteTemplates(replaced); });
+    return true;
 }
 
 // Checks validity of the loot store
 // Actual checks are done within LootTemplate::Verify() which is called for every template
 void LootStore::Verify() const
 {
-    for (const auto& m_LootTemplate : m_LootTemplates)
+    for (const auto& m_LootTemplate : GetTemplates())
         m_LootTemplate.second->Verify(*this, m_LootTemplate.first);
 }
 
@@ -99,8 +130,8 @@ void LootStore::LoadLootTable()
     LootTemplateMap::const_iterator tab;
     uint32 count = 0;
 
-    // Clearing store (for reloading case)
-    Clear();
+    // built next to current templates, they stay in use until replaced
+    LootTemplateMap* templates = new LootTemplateMap;
 
     //                                                 0      1     2                    3        4              5         6
     QueryResult* result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
@@ -151,13 +182,13 @@ void LootStore::LoadLootTable()
 
             // Looking for the template of the entry
             // often entries are put together
-            if (m_LootTemplates.empty() || tab->first != entry)
+            if (templates->empty() || tab->first != entry)
             {
                 // Searching the template (in case template Id changed)
-                tab = m_LootTemplates.find(entry);
-                if (tab == m_LootTemplates.end())
+                tab = templates->find(entry);
+                if (tab == templates->end())
                 {
-                    std::pair< LootTemplateMap::iterator, bool > pr = m_LootTemplates.insert(LootTemplateMap::value_type(entry, new LootTemplate));
+                    std::pair< LootTemplateMap::iterator, bool > pr = templates->insert(LootTemplateMap::value_type(entry, new LootTemplate));
                     tab = pr.first;
                 }
             }
@@ -169,12 +200,24 @@ void LootStore::LoadLootTable()
             ++count;
         }
         while (result->NextRow());
+    }
 
+    // reload thread keeps them until ApplyLoadedTemplates, at server load they replace empty store
+    if (ReloadMgr::IsReloadThread())
+    {
+        DeleteTemplates(m_loadedTemplates);
+        m_loadedTemplates = templates;
+    }
+    else
+        DeleteTemplates(m_LootTemplates.exchange(templates));
+
+    if (result)
+    {
         delete result;
 
         Verify();                                           // Checks validity of the loot store
 
-        sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, m_LootTemplates.size(), GetName());
+        sLog.outString(">> Loaded %u loot definitions (" SIZEFMTD " templates) from table %s", count, templates->size(), GetName());
         sLog.outString();
     }
     else
@@ -186,19 +229,21 @@ void LootStore::LoadLootTable()
 
 bool LootStore::HaveQuestLootFor(uint32 loot_id) const
 {
-    LootTemplateMap::const_iterator itr = m_LootTemplates.find(loot_id);
-    if (itr == m_LootTemplates.end())
+    LootTemplateMap const& templates = GetTemplates();
+    LootTemplateMap::const_iterator itr = templates.find(loot_id);
+    if (itr == templates.end())
         return false;
 
     // scan loot for quest items
-    return itr->second->HasQuestDrop(m_LootTemplates);
+    return itr->second->HasQuestDrop(templates);
 }
 
 bool LootStore::HaveQuestLootForPlayer(uint32 loot_id, Player* player) const
 {
-    LootTemplateMap::const_iterator tab = m_LootTemplates.find(loot_id);
-    if (tab != m_LootTemplates.end())
-        if (tab->second->HasQuestDropForPlayer(m_LootTemplates, player))
+    LootTemplateMap const& templates = GetTemplates();
+    LootTemplateMap::const_iterator tab = templates.find(loot_id);
+    if (tab != templates.end())
+        if (tab->second->HasQuestDropForPlayer(templates, player))
             return true;
 
     return false;
@@ -206,9 +251,10 @@ bool LootStore::HaveQuestLootForPlayer(uint32 loot_id, Player* player) const
 
 LootTemplate const* LootStore::GetLootFor(uint32 loot_id) const
 {
-    LootTemplateMap::const_iterator tab = m_LootTemplates.find(loot_id);
+    LootTemplateMap const& templates = GetTemplates();
+    LootTemplateMap::const_iterator tab = templates.find(loot_id);
 
-    if (tab == m_LootTemplates.end())
+    if (tab == templates.end())
         return nullptr;
 
     return tab->second;
@@ -218,13 +264,13 @@ void LootStore::LoadAndCollectLootIds(LootIdSet& ids_set)
 {
     LoadLootTable();
 
-    for (LootTemplateMap::const_iterator tab = m_LootTemplates.begin(); tab != m_LootTemplates.end(); ++tab)
-        ids_set.insert(tab->first);
+    for (const auto& tab : GetTemplates())
+        ids_set.insert(tab.first);
 }
 
 void LootStore::CheckLootRefs(LootIdSet* ref_set) const
 {
-    for (const auto& m_LootTemplate : m_LootTemplates)
+    for (const auto& m_LootTemplate : GetTemplates())
         m_LootTemplate.second->CheckLootRefs(ref_set);
 }
 
@@ -333,13 +379,7 @@ bool LootStoreItem::IsValid(LootStore const& store, uint32 entry) const
 // Constructor, copies most fields from LootStoreItem and generates random count
 LootItem::LootItem(LootStoreItem const& li, uint32 _lootSlot, uint32 threshold)
 {
-    if (li.needs_quest)
-        lootItemType = LOOTITEM_TYPE_QUEST;
-    else if (li.conditionId)
-        lootItemType = LOOTITEM_TYPE_CONDITIONNAL;
-    else
-        lootItemType = LOOTITEM_TYPE_NORMAL;
-
+    lootItemType      = GetLootItemType(li);
     itemProto         = ObjectMgr::GetItemPrototype(li.itemid);
     if (itemProto)
     {
@@ -396,8 +436,28 @@ LootItem::LootItem(uint32 _itemId, uint32 _count, uint32 _randomSuffix, int32 _r
 }
 
 
+LootItemType LootItem::GetLootItemType(LootStoreItem const& li)
+{
+    if (li.needs_quest)
+        return LOOTITEM_TYPE_QUEST;
+    if (li.conditionId)
+        return LOOTITEM_TYPE_CONDITIONNAL;
+    return LOOTITEM_TYPE_NORMAL;
+}
+
 // Basic checks for player/item compatibility - if false no chance to see the item in the loot
 bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTarget) const
+{
+    return AllowedForPlayer(player, lootTarget, itemProto, lootItemType, conditionId, itemId);
+}
+
+bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTarget, LootStoreItem const& li)
+{
+    return AllowedForPlayer(player, lootTarget, ObjectMgr::GetItemPrototype(li.itemid), GetLootItemType(li), li.conditionId, li.itemid);
+}
+
+bool LootItem::AllowedForPlayer(Player const* player, WorldObject const* lootTarget, ItemPrototype const* itemProto,
+                                LootItemType lootItemType, uint16 conditionId, uint32 itemId)
 {
     if (!itemProto)
         return false;
@@ -879,8 +939,8 @@ void Loot::AddItem(uint32 itemid, uint32 count, uint32 randomSuffix, int32 rando
 // Calls processor of corresponding LootTemplate (which handles everything including references)
 bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool /*personal*/, bool noEmptyError)
 {
-    // Must be provided
-    if (!lootOwner)
+    // Must be provided, delayed corpse loot uses owners state taken at creature death instead
+    if (!lootOwner && !m_delayedOwnerState)
         return false;
 
     LootTemplate const* tab = store.GetLootFor(loot_id);
@@ -897,21 +957,35 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
     tab->Process(*this, lootOwner, store, store.IsRatesAllowed()); // Processing is done there, callback via Loot::AddItem()
 
     // fill the loot owners right here so its impossible from this point to change loot result
-    Player* masterLooter = nullptr;
+    bool hasMasterLooter = false;
     if (m_lootMethod == MASTER_LOOT)
-        masterLooter = ObjectAccessor::FindPlayer(m_masterOwnerGuid);
+    {
+        if (m_delayedOwnerState)
+            hasMasterLooter = m_delayedOwnerState->owners.find(m_masterOwnerGuid) != m_delayedOwnerState->owners.end();
+        else
+            hasMasterLooter = ObjectAccessor::FindPlayer(m_masterOwnerGuid) != nullptr;
+    }
 
     for (auto playerGuid : m_ownerSet)
     {
-        Player* player = ObjectAccessor::FindPlayer(playerGuid);
+        Player* player = m_delayedOwnerState ? nullptr : ObjectAccessor::FindPlayer(playerGuid);
 
         // assign permission for non chest items
         for (auto lootItem : m_lootItems)
         {
-            if (player && (lootItem->AllowedForPlayer(player, GetLootTarget())))
+            bool allowed;
+            if (m_delayedOwnerState)
+            {
+                auto itr = m_delayedOwnerState->allowedItems.find(lootItem->itemId);
+                allowed = itr != m_delayedOwnerState->allowedItems.end() && itr->second.find(playerGuid) != itr->second.end();
+            }
+            else
+                allowed = player && lootItem->AllowedForPlayer(player, GetLootTarget());
+
+            if (allowed)
             {
                 if (!m_isChest)
-                    lootItem->allowedGuid.emplace(player->GetObjectGuid());
+                    lootItem->allowedGuid.emplace(playerGuid);
             }
             else
             {
@@ -934,7 +1008,7 @@ bool Loot::FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, b
                 case MASTER_LOOT:
                 {
                     // roll item if masterloot is not in the list or if masterloot have no right for this item
-                    if (!masterLooter || lootItem->allowedGuid.find(m_masterOwnerGuid) == lootItem->allowedGuid.end())
+                    if (!hasMasterLooter || lootItem->allowedGuid.find(m_masterOwnerGuid) == lootItem->allowedGuid.end())
                         lootItem->isBlocked = true;
                     break;
                 }
@@ -1012,6 +1086,10 @@ bool Loot::CanLoot(Player const* player)
     if (itr == m_ownerSet.end())
         return false;
 
+    // content is not known before first open
+    if (m_isDelayed)
+        return true;
+
     uint32 lootStatus = GetLootStatusFor(player);
 
     // is already looted?
@@ -1383,6 +1461,9 @@ void Loot::Release(Player* player)
 // Popup windows with loot content
 void Loot::ShowContentTo(Player* plr)
 {
+    if (m_isDelayed)
+        FillDelayedLoot();
+
     if (!m_isChest)
     {
         // for item loot that might be empty we should not display error but instead send empty loot window
@@ -1590,7 +1671,7 @@ void Loot::SetGroupLootRight(Player* player)
 Loot::Loot(Player* player, Creature* creature, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1617,31 +1698,22 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
             SetGroupLootRight(player);
             m_clientLootType = CLIENT_LOOT_CORPSE;
 
-            if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+            // many corpses are never opened, roll the content at first open with a seed taken now
+            // skinnable corpses need to know at once if they are empty, skinning is only possible after
+            if (sWorld.getConfig(CONFIG_BOOL_CORPSE_DELAYED_LOOT_GENERATION) && !creatureInfo->SkinningLootId &&
+                    (creatureInfo->LootId || creatureInfo->MaxLootGold > 0))
             {
-                GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
-                // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
-                bool isLootedForAll = IsLootedForAll();
-                if (isLootedForAll)
-                {
-                    // show sometimes an empty window
-                    if (sWorld.getConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW) && urand(0, 2) == 1)
-                    {
-                        m_isFakeLoot = true;
-                        isLootedForAll = false;
-                    }
-                }
+                m_isDelayed = true;
+                m_delayedSeed = urand();
+                SetDelayedOwnerState(player, creatureInfo->LootId);
+                sLootMgr.AddDelayedCorpseLoot();
 
-                if (!isLootedForAll)
-                    creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                else
-                    creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+                creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
                 ForceLootAnimationClientUpdate();
                 break;
             }
 
-            sLog.outDebug("Loot::CreateLoot> cannot create corpse loot, FillLoot failed with loot id(%u)!", creatureInfo->LootId);
-            creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+            FillCorpseLoot(player, false);
             break;
         }
         case LOOT_PICKPOCKETING:
@@ -1689,10 +1761,86 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
     return;
 }
 
+// delayed is true when the corpse was shown lootable before the roll
+void Loot::FillCorpseLoot(Player* player, bool delayed)
+{
+    Creature* creature = static_cast<Creature*>(m_lootTarget);
+    CreatureInfo const* creatureInfo = creature->GetCreatureInfo();
+
+    if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+    {
+        GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+        // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
+        bool isLootedForAll = IsLootedForAll();
+        if (isLootedForAll)
+        {
+            // show sometimes an empty window, always if it is already opened
+            if (delayed || (sWorld.getConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW) && urand(0, 2) == 1))
+            {
+                m_isFakeLoot = true;
+                isLootedForAll = false;
+            }
+        }
+
+        if (!isLootedForAll)
+            creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+        else
+            creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+        ForceLootAnimationClientUpdate();
+        return;
+    }
+
+    sLog.outDebug("Loot::CreateLoot> cannot create corpse loot, FillLoot failed with loot id(%u)!", creatureInfo->LootId);
+    // the empty window is released as looted
+    if (delayed)
+        m_isFakeLoot = true;
+    else
+        creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+}
+
+// keeps everything the corpse loot roll asks the loot owners, quests and groups may change before first open
+void Loot::SetDelayedOwnerState(Player* player, uint32 lootId)
+{
+    std::unique_ptr<DelayedLootOwnerState> state(new DelayedLootOwnerState);
+
+    std::vector<LootStoreItem const*> entries;
+    if (LootTemplate const* tab = lootId ? LootTemplates_Creature.GetLootFor(lootId) : nullptr)
+        tab->CollectEntries(entries);
+
+    for (auto entry : entries)
+        if (entry->conditionId && LootTemplate::PlayerOrGroupFulfilsCondition(*this, player, entry->conditionId))
+            state->fulfilledConditions.insert(entry->conditionId);
+
+    for (auto playerGuid : m_ownerSet)
+    {
+        Player* owner = ObjectAccessor::FindPlayer(playerGuid);
+        if (!owner)
+            continue;
+
+        state->owners.insert(playerGuid);
+        for (auto entry : entries)
+            if (LootItem::AllowedForPlayer(owner, GetLootTarget(), *entry))
+                state->allowedItems[entry->itemid].insert(playerGuid);
+    }
+
+    m_delayedOwnerState = std::move(state);
+}
+
+// rolls delayed corpse content, seed and owners state taken at creature death give same result as rolled then
+void Loot::FillDelayedLoot()
+{
+    m_isDelayed = false;
+    sLootMgr.AddOpenedCorpseLoot();
+
+    ScopedRandomSeed seed(m_delayedSeed);
+    FillCorpseLoot(nullptr, true);
+    m_delayedOwnerState.reset();
+}
+
 Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1789,7 +1937,7 @@ Loot::Loot(Player* player, GameObject* gameObject, LootType type) :
 Loot::Loot(Player* player, Corpse* corpse, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1836,7 +1984,7 @@ Loot::Loot(Player* player, Corpse* corpse, LootType type) :
 Loot::Loot(Player* player, Item* item, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1875,7 +2023,7 @@ Loot::Loot(Player* player, Item* item, LootType type) :
 Loot::Loot(Unit* unit, Item* item) :
     m_lootTarget(nullptr), m_itemTarget(item), m_gold(0), m_maxSlot(0),
     m_lootType(LOOT_SKINNING), m_clientLootType(CLIENT_LOOT_PICKPOCKETING), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0),
-    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(unit->GetObjectGuid());
     m_guidTarget = item->GetObjectGuid();
@@ -1884,7 +2032,7 @@ Loot::Loot(Unit* unit, Item* item) :
 Loot::Loot(Player* player, uint32 id, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(player->GetObjectGuid());
     switch (type)
@@ -1906,7 +2054,7 @@ Loot::Loot(Player* player, uint32 id, LootType type) :
 Loot::Loot(LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0), m_createTime(World::GetCurrentClockTime())
 {
 
 }
@@ -2122,6 +2270,9 @@ void Loot::GetLootItemsListFor(Player* player, LootItemList& lootList)
 
 Loot::~Loot()
 {
+    if (m_isDelayed)
+        sLootMgr.AddDiscardedCorpseLoot();
+
     SendReleaseForAll();
     for (auto& m_lootItem : m_lootItems)
         delete m_lootItem;
@@ -2214,6 +2365,12 @@ void Loot::PrintLootList(ChatHandler& chat, WorldSession* session) const
         return;
     }
 
+    if (m_isDelayed)
+    {
+        chat.PSendSysMessage("Loot is not generated before first open.");
+        return;
+    }
+
     if (m_gold == 0)
         chat.PSendSysMessage("Loot have no money");
     else
@@ -2318,7 +2475,7 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
         {
             LootStoreItem const* lsi = *itr;
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+            if (lsi->conditionId && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
             {
                 sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
                 continue;
@@ -2359,7 +2516,7 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
                     continue;                               // pass this item
             }
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+            if (lsi->conditionId && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
             {
                 sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
                 continue;
@@ -2403,6 +2560,15 @@ void LootTemplate::LootGroup::Process(Loot& loot, Player const* lootOwner) const
         loot.AddItem(*item);
 }
 
+// Adds all entries of the group
+void LootTemplate::LootGroup::CollectEntries(std::vector<LootStoreItem const*>& entries) const
+{
+    for (auto& i : ExplicitlyChanced)
+        entries.push_back(&i);
+    for (auto& i : EqualChanced)
+        entries.push_back(&i);
+}
+
 // Overall chance for the group without equal chanced items
 float LootTemplate::LootGroup::RawTotalChance() const
 {
@@ -2498,7 +2664,7 @@ void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const&
     for (auto Entrie : Entries)
     {
         // Check condition
-        if (Entrie.conditionId && lootOwner && !PlayerOrGroupFulfilsCondition(loot, lootOwner, Entrie.conditionId))
+        if (Entrie.conditionId && !PlayerOrGroupFulfilsCondition(loot, lootOwner, Entrie.conditionId))
             continue;
 
         if (!Entrie.Roll(rate))
@@ -2523,6 +2689,31 @@ void LootTemplate::Process(Loot& loot, Player const* lootOwner, LootStore const&
         Group.Process(loot, lootOwner);
 }
 
+// Adds all item entries the template may roll, references included
+void LootTemplate::CollectEntries(std::vector<LootStoreItem const*>& entries, uint8 groupId) const
+{
+    if (groupId)                                            // Group reference
+    {
+        if (groupId <= Groups.size())
+            Groups[groupId - 1].CollectEntries(entries);
+        return;
+    }
+
+    for (auto& Entrie : Entries)
+    {
+        if (Entrie.mincountOrRef < 0)                       // References
+        {
+            if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(-Entrie.mincountOrRef))
+                Referenced->CollectEntries(entries, Entrie.group);
+        }
+        else
+            entries.push_back(&Entrie);
+    }
+
+    for (const auto& Group : Groups)
+        Group.CollectEntries(entries);
+}
+
 // True if template includes at least 1 quest drop entry
 bool LootTemplate::HasQuestDrop(LootTemplateMap const& store, uint8 groupId) const
 {
@@ -2590,6 +2781,12 @@ bool LootTemplate::HasQuestDropForPlayer(LootTemplateMap const& store, Player co
 
 bool LootTemplate::PlayerOrGroupFulfilsCondition(const Loot& loot, Player const* lootOwner, uint16 conditionId)
 {
+    if (DelayedLootOwnerState const* state = loot.GetDelayedOwnerState())
+        return state->fulfilledConditions.find(conditionId) != state->fulfilledConditions.end();
+
+    if (!lootOwner)
+        return true;
+
     Map* map = lootOwner->IsInWorld() ? lootOwner->GetMap() : loot.GetLootTarget()->GetMap(); // if neither succeeds, we have a design problem
     auto& ownerSet = loot.GetOwnerSet();
     // optimization - no need to look up when player is solo
@@ -2841,6 +3038,46 @@ void LoadLootTemplates_Reference()
     LootTemplates_Reference.ReportUnusedIds(ids_set);
 }
 
+static LootStore* const allLootStores[] =
+{
+    &LootTemplates_Creature, &LootTemplates_Disenchant, &LootTemplates_Fishing, &LootTemplates_Gameobject, &LootTemplates_Item,
+    &LootTemplates_Mail, &LootTemplates_Pickpocketing, &LootTemplates_Reference, &LootTemplates_Skinning
+};
+
+class LootTemplatesReload : public BackgroundReload
+{
+    public:
+        LootTemplatesReload(char const* tableName, void (*loader)()) : BackgroundReload(tableName), m_loader(loader) {}
+
+        void Load() override
+        {
+            m_loader();
+
+            // already checked for all stores by reference templates load
+            if (LootTemplates_Reference.HasLoadedTemplates())
+                return;
+
+            // reload thread sees loaded templates instead of published ones
+            for (LootStore* store : allLootStores)
+                if (store->HasLoadedTemplates())
+                    store->CheckLootRefs();
+        }
+
+        void Apply() override
+        {
+            for (LootStore* store : allLootStores)
+                store->ApplyLoadedTemplates();
+        }
+
+    private:
+        void (*m_loader)();
+};
+
+void ReloadLootTemplates(char const* tableName, void (*loader)())
+{
+    sReloadMgr.AddReload(new LootTemplatesReload(tableName, loader));
+}
+
 // Vote for an ongoing roll
 void LootMgr::PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint32 itemSlot, RollVote vote)
 {
@@ -2926,6 +3163,16 @@ Loot* LootMgr::GetLoot(Player* player, ObjectGuid const& targetGuid) const
     return loot;
 }
 
+void LootMgr::PrintCorpseLootStats(ChatHandler& chat) const
+{
+    uint32 delayed = m_delayedCorpseLoots;
+    uint32 opened = m_openedCorpseLoots;
+    uint32 discarded = m_discardedCorpseLoots;
+
+    chat.PSendSysMessage("Delayed corpse loots: %u, generated at first open: %u, removed without open: %u, pending: %u",
+                         delayed, opened, discarded, delayed - opened - discarded);
+}
+
 void LootMgr::CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore) const
 {
     // choose correct loot template
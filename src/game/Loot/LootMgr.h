@@ -24,6 +24,9 @@
 #include "Globals/SharedDefines.h"
 
 #include <vector>
+#include <atomic>
+#include <map>
+#include <memory>
 #include "Entities/Bag.h"
 
 #define LOOT_ROLL_TIMEOUT  (1*MINUTE*IN_MILLISECONDS)
@@ -210,8 +213,15 @@ struct LootItem
 
     // Basic checks for player/item compatibility - if false no chance to see the item in the loot
     bool AllowedForPlayer(Player const* player, WorldObject const* lootTarget) const;
+    // The same for a template entry before it is rolled
+    static bool AllowedForPlayer(Player const* player, WorldObject const* lootTarget, LootStoreItem const& li);
     LootSlotType GetSlotTypeForSharedLoot(Player const* player, Loot const* loot) const;
     bool IsAllowed(Player const* player, Loot const* loot) const;
+
+    private:
+        static LootItemType GetLootItemType(LootStoreItem const& li);
+        static bool AllowedForPlayer(Player const* player, WorldObject const* lootTarget, ItemPrototype const* itemProto,
+                                     LootItemType lootItemType, uint16 conditionId, uint32 itemId);
 };
 
 typedef std::vector<LootItem*> LootItemList;
@@ -223,8 +233,8 @@ class LootStore
 {
     public:
         explicit LootStore(char const* name, char const* entryName, bool ratesAllowed)
-            : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed) {}
-        virtual ~LootStore() { Clear(); }
+            : m_LootTemplates(new LootTemplateMap), m_loadedTemplates(nullptr), m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed) {}
+        virtual ~LootStore();
 
         void Verify() const;
 
@@ -233,7 +243,7 @@ class LootStore
         void ReportUnusedIds(LootIdSet const& ids_set) const;
         void ReportNotExistedId(uint32 id) const;
 
-        bool HaveLootFor(uint32 loot_id) const { return m_LootTemplates.find(loot_id) != m_LootTemplates.end(); }
+        bool HaveLootFor(uint32 loot_id) const { return GetTemplates().find(loot_id) != GetTemplates().end(); }
         bool HaveQuestLootFor(uint32 loot_id) const;
         bool HaveQuestLootForPlayer(uint32 loot_id, Player* player) const;
 
@@ -242,11 +252,19 @@ class LootStore
         char const* GetName() const { return m_name; }
         char const* GetEntryName() const { return m_entryName; }
         bool IsRatesAllowed() const { return m_ratesAllowed; }
+
+        // publish templates loaded by reload thread, replaced ones are retired in sReloadMgr
+        bool HasLoadedTemplates() const { return m_loadedTemplates != nullptr; }
+        bool ApplyLoadedTemplates();
     protected:
         void LoadLootTable();
-        void Clear();
     private:
-        LootTemplateMap m_LootTemplates;
+        // reload thread sees templates it loaded before they are published
+        LootTemplateMap const& GetTemplates() const;
+        static void DeleteTemplates(LootTemplateMap* templates);
+
+        std::atomic<LootTemplateMap*> m_LootTemplates;
+        LootTemplateMap* m_loadedTemplates;                 // reload thread only until applied
         char const* m_name;
         char const* m_entryName;
         bool m_ratesAllowed;
@@ -269,6 +287,8 @@ class LootTemplate
         bool HasQuestDropForPlayer(LootTemplateMap const& store, Player const* player, uint8 groupId = 0) const;
         // True if at least one player fulfils loot condition
         static bool PlayerOrGroupFulfilsCondition(const Loot& loot, Player const* lootOwner, uint16 conditionId);
+        // Adds all item entries the template may roll, references included
+        void CollectEntries(std::vector<LootStoreItem const*>& entries, uint8 groupId = 0) const;
 
         // Checks integrity of the template
         void Verify(LootStore const& lootstore, uint32 id) const;
@@ -282,6 +302,14 @@ class LootTemplate
 
 ByteBuffer& operator<<(ByteBuffer& b, LootItem const& li);
 
+// loot owners state taken at creature death, delayed corpse loot is rolled against it
+struct DelayedLootOwnerState
+{
+    GuidSet owners;                                         // loot owners in world at creature death
+    std::set<uint16> fulfilledConditions;                   // roll conditions fulfilled by killer or its group
+    std::map<uint32, GuidSet> allowedItems;                 // owners allowed to loot the item of template entries
+};
+
 class Loot
 {
     public:
@@ -324,11 +352,13 @@ class Loot
         ObjectGuid const& GetMasterLootGuid() const { return m_masterOwnerGuid; }
         GuidSet const& GetOwnerSet() const { return m_ownerSet; }
         TimePoint const& GetCreateTime() const { return m_createTime; }
+        // not null until delayed corpse loot is rolled, see Corpse.DelayedLootGeneration
+        DelayedLootOwnerState const* GetDelayedOwnerState() const { return m_delayedOwnerState.get(); }
 
     private:
         Loot(): m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(),
             m_clientLootType(), m_lootMethod(), m_threshold(), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false)
+            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDelayed(false), m_delayedSeed(0)
         {}
         void Clear();
         bool IsLootedFor(Player const* player) const;
@@ -343,6 +373,9 @@ class Loot
         void GroupCheck();
         void SetGroupLootRight(Player* player);
         void GenerateMoneyLoot(uint32 minAmount, uint32 maxAmount);
+        void FillCorpseLoot(Player* player, bool delayed);
+        void FillDelayedLoot();
+        void SetDelayedOwnerState(Player* player, uint32 lootId);
         bool FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool personal, bool noEmptyError = false);
         void ForceLootAnimationClientUpdate() const;
         void SetPlayerIsLooting(Player* player);
@@ -372,6 +405,9 @@ class Loot
         bool             m_isChest;                       // chest type object have special loot right
         bool             m_isChanged;                     // true if at least one item is looted
         bool             m_isFakeLoot;                    // nothing to loot but will sparkle for empty windows
+        bool             m_isDelayed;                     // corpse content not rolled yet, done at first open
+        uint32           m_delayedSeed;                   // random seed taken at creature death for delayed roll
+        std::unique_ptr<DelayedLootOwnerState> m_delayedOwnerState; // owners state at creature death for delayed roll
         GroupLootRollMap m_roll;                          // used if an item is under rolling
         GuidSet          m_playersLooting;                // player who opened loot windows
         GuidSet          m_playersOpened;                 // players that have released the corpse
@@ -398,6 +434,9 @@ void LoadLootTemplates_Disenchant();
 
 void LoadLootTemplates_Reference();
 
+// loader is called by reload thread, all loot stores loaded by it are published together
+void ReloadLootTemplates(char const* tableName, void (*loader)());
+
 inline void LoadLootTables()
 {
     LoadLootTemplates_Creature();
@@ -416,8 +455,22 @@ class LootMgr
 {
     public:
         void PlayerVote(Player* player, ObjectGuid const& lootTargetGuid, uint32 itemSlot, RollVote vote);
+        LootMgr() : m_delayedCorpseLoots(0), m_openedCorpseLoots(0), m_discardedCorpseLoots(0) {}
+
         Loot* GetLoot(Player* player, ObjectGuid const& targetGuid = ObjectGuid()) const;
         void CheckDropStats(ChatHandler& chat, uint32 amountOfCheck, uint32 lootId, std::string lootStore) const;
+
+        // corpse loot delayed until first open, see Corpse.DelayedLootGeneration
+        void AddDelayedCorpseLoot() { ++m_delayedCorpseLoots; }
+        void AddOpenedCorpseLoot() { ++m_openedCorpseLoots; }
+        void AddDiscardedCorpseLoot() { ++m_discardedCorpseLoots; }
+        void PrintCorpseLootStats(ChatHandler& chat) const;
+
+    private:
+        // updated from map threads
+        std::atomic<uint32> m_delayedCorpseLoots;
+        std::atomic<uint32> m_openedCorpseLoots;
+        std::atomic<uint32> m_discardedCorpseLoots;
 };
 
 #define sLootMgr MaNGOS::Singleton<LootMgr>::Instance()
@@ -297,20 +297,7 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
     uint32 mailId = sObjectMgr.GenerateMailID();
 
     time_t deliver_time = time(nullptr) + deliver_delay;
-
-    // expire time if COD 3 days, if no COD 30 days, if auction sale pending 1 hour
-    uint32 expire_delay;
-    // auction mail without any items and money (auction sale note) pending 1 hour
-    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
-        expire_delay = HOUR;
-    // mail from battlemaster (rewardmarks) should last only one day
-    else if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
-        expire_delay = DAY;
-    // default case: expire time if COD 3 days, if no COD 30 days
-    else
-        expire_delay = (m_COD > 0) ? 3 * DAY : 30 * DAY;
-
-    time_t expire_time = deliver_time + expire_delay;
+    time_t expire_time = deliver_time + GetExpireDelay(sender);
 
     // Add to DB
     std::string safe_subject = GetSubject();
@@ -369,6 +356,104 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         deleteIncludedItems();
 }
 
+/**
+ * Returns the time a mail of this draft stays in the mailbox of the receiver.
+ *
+ * @param sender               sender of the mail
+ */
+uint32 MailDraft::GetExpireDelay(MailSender const& sender) const
+{
+    // auction mail without any items and money (auction sale note) pending 1 hour
+    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
+        return HOUR;
+    // mail from battlemaster (rewardmarks) should last only one day
+    if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
+        return DAY;
+    // default case: expire time if COD 3 days, if no COD 30 days
+    return (m_COD > 0) ? 3 * DAY : 30 * DAY;
+}
+
+/// Max rows stored by one insert of SendMailToOffline, text rows can be long
+#define MAIL_BULK_INSERT_ROWS       500
+#define MAIL_BULK_INSERT_MAX_LENGTH (512 * 1024)
+
+/**
+ * Sends a copy of the draft to many offline characters, the mails are stored with multi-row inserts in one transaction.
+ * Only drafts without items can be sent this way, mail template items are generated at mail loading for offline receivers.
+ *
+ * @param receiverLowGuids     existing characters not in game, use SendMailTo for online ones
+ * @param sender               sender of the mails
+ * @param checked              mail check mask of the mails
+ * @param lastUse              the draft is not sent after this call, so its own body text is given to the first mail
+ */
+void MailDraft::SendMailToOffline(std::vector<uint32> const& receiverLowGuids, MailSender const& sender, MailCheckMask checked, bool lastUse)
+{
+    MANGOS_ASSERT(m_items.empty());
+
+    if (receiverLowGuids.empty())
+        return;
+
+    time_t deliver_time = time(nullptr);
+    time_t expire_time = deliver_time + GetExpireDelay(sender);
+
+    std::string safe_subject = GetSubject();
+    CharacterDatabase.escape_string(safe_subject);
+
+    // every mail needs its own body text, it is deleted with the mail
+    std::string text;
+    std::string safe_text;
+    if (m_bodyId)
+    {
+        text = sObjectMgr.GetItemText(m_bodyId);
+        safe_text = text;
+        CharacterDatabase.escape_string(safe_text);
+    }
+
+    std::ostringstream mailValues;
+    std::ostringstream textValues;
+    uint32 rows = 0;
+    uint32 textRows = 0;
+
+    CharacterDatabase.BeginTransaction();
+    for (std::vector<uint32>::const_iterator itr = receiverLowGuids.begin(); itr != receiverLowGuids.end(); ++itr)
+    {
+        uint32 bodyId = 0;
+        if (m_bodyId)
+        {
+            if (lastUse && itr == receiverLowGuids.begin())
+                bodyId = m_bodyId;
+            else
+            {
+                bodyId = sObjectMgr.GenerateItemTextID();
+                sObjectMgr.AddItemText(bodyId, text);
+                textValues << (textRows ? "," : "") << "('" << bodyId << "','" << safe_text << "')";
+                ++textRows;
+            }
+        }
+
+        mailValues << (rows ? "," : "")
+                   << "('" << sObjectMgr.GenerateMailID() << "','" << uint32(sender.GetMailMessageType()) << "','" << uint32(sender.GetStationery())
+                   << "','" << GetMailTemplateId() << "','" << sender.GetSenderId() << "','" << *itr << "','" << safe_subject
+                   << "','" << bodyId << "','0','" << uint64(expire_time) << "','" << uint64(deliver_time)
+                   << "','" << m_money << "','" << m_COD << "','" << uint32(checked) << "')";
+
+        if (++rows < MAIL_BULK_INSERT_ROWS && textRows * safe_text.size() < MAIL_BULK_INSERT_MAX_LENGTH && std::next(itr) != receiverLowGuids.end())
+            continue;
+
+        // Execute instead PExecute, statements are longer than MAX_QUERY_LEN
+        if (textRows)
+            CharacterDatabase.Execute(("INSERT INTO item_text (id,text) VALUES " + textValues.str()).c_str());
+
+        CharacterDatabase.Execute(("INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,itemTextId,has_items,expire_time,deliver_time,money,cod,checked) VALUES " + mailValues.str()).c_str());
+
+        mailValues.str("");
+        textValues.str("");
+        rows = 0;
+        textRows = 0;
+    }
+    CharacterDatabase.CommitTransaction();
+}
+
 /**
  * Generate items from template at mails loading (this happens when mail with mail template items send in time when receiver has been offline)
  *
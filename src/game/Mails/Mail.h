@@ -227,6 +227,8 @@ class MailDraft
         uint32 GetMoney() const { return m_money; }
         /// Returns the Cost of delivery of this MailDraft.
         uint32 GetCOD() const { return m_COD; }
+        /// Returns true if real items are attached to this MailDraft (template items are not counted).
+        bool HasItems() const { return !m_items.empty(); }
     public:                                                 // modifiers
 
         // this two modifiers expected to be applied in normal case to blank draft and exclusively, It DON'T must overwrite already set itemTextId, in other cases it will work and with mixed cases but this will be not normal way use.
@@ -252,12 +254,14 @@ class MailDraft
     public:                                                 // finishers
         void SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, ObjectGuid receiver_guid);
         void SendMailTo(MailReceiver const& receiver, MailSender const& sender, MailCheckMask checked = MAIL_CHECK_MASK_NONE, uint32 deliver_delay = 0);
+        void SendMailToOffline(std::vector<uint32> const& receiverLowGuids, MailSender const& sender, MailCheckMask checked, bool lastUse);
     private:
         MailDraft(MailDraft const&);                        // trap decl, no body, mail draft must cloned only explicitly...
         MailDraft& operator=(MailDraft const&);             // trap decl, no body, ...because items clone is high price operation
 
         void deleteIncludedItems(bool inDB = false);
         bool prepareItems(Player* receiver);                ///< called from SendMailTo for generate mailTemplateBase items
+        uint32 GetExpireDelay(MailSender const& sender) const;
 
         /// The ID of the template associated with this MailDraft.
         uint16      m_mailTemplateId;
@@ -77,11 +77,30 @@ void MassMailMgr::Update(bool sendall /*= false*/)
         return;
 
     uint32 maxcount = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK);
+    uint32 bulkcount = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_BULK_SEND_PER_TICK);
 
     do
     {
         MassMail& task = m_massMails.front();
 
+        // mails without items to not online characters can be stored in bulk
+        if (!task.m_protoMail->HasItems())
+        {
+            if (!sendall && bulkcount == 0)
+                break;
+
+            if (sendall)
+                UpdateBulk(task, task.m_receivers.size());
+            else
+                bulkcount -= UpdateBulk(task, bulkcount);
+            if (task.m_receivers.empty())
+                m_massMails.pop_front();
+            continue;
+        }
+
+        if (!sendall && maxcount == 0)
+            break;
+
         while (!task.m_receivers.empty() && (sendall || maxcount > 0))
         {
             uint32 receiver_lowguid = *task.m_receivers.begin();
@@ -115,7 +134,51 @@ void MassMailMgr::Update(bool sendall /*= false*/)
         if (task.m_receivers.empty())
             m_massMails.pop_front();
     }
-    while (!m_massMails.empty() && (sendall || maxcount > 0));
+    while (!m_massMails.empty() && (sendall || maxcount > 0 || bulkcount > 0));
+}
+
+uint32 MassMailMgr::UpdateBulk(MassMail& task, uint32 maxcount)
+{
+    std::vector<uint32> offlineReceivers;
+    bool protoUsed = false;
+    uint32 count = 0;
+
+    while (!task.m_receivers.empty() && count < maxcount)
+    {
+        uint32 receiver_lowguid = *task.m_receivers.begin();
+        task.m_receivers.erase(task.m_receivers.begin());
+        ++count;
+
+        ObjectGuid receiver_guid = ObjectGuid(HIGHGUID_PLAYER, receiver_lowguid);
+        Player* receiver = sObjectMgr.GetPlayer(receiver_guid);
+
+        // not in game, stored with others below
+        if (!receiver)
+        {
+            offlineReceivers.push_back(receiver_lowguid);
+            continue;
+        }
+
+        // last case without offline receivers left. can be just send
+        if (task.m_receivers.empty() && offlineReceivers.empty())
+        {
+            // prevent mail return
+            task.m_protoMail->SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+            protoUsed = true;
+            break;
+        }
+
+        // online receiver need mail in memory also, so clone draft and send as usual
+        MailDraft draft;
+        draft.CloneFrom(*task.m_protoMail);
+
+        // prevent mail return
+        draft.SendMailTo(MailReceiver(receiver, receiver_guid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+    }
+
+    // prevent mail return
+    task.m_protoMail->SendMailToOffline(offlineReceivers, task.m_sender, MAIL_CHECK_MASK_RETURNED, task.m_receivers.empty() && !protoUsed);
+    return count;
 }
 
 void MassMailMgr::GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) const
@@ -123,13 +186,17 @@ void MassMailMgr::GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) c
     tasks = m_massMails.size();
 
     uint32 mailsCount = 0;
+    uint32 ticksCount = 0;
     for (const auto& m_massMail : m_massMails)
+    {
         mailsCount += m_massMail.m_receivers.size();
+        ticksCount += m_massMail.m_receivers.size() / sWorld.getConfig(m_massMail.m_protoMail->HasItems() ? CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK : CONFIG_UINT32_MASS_MAILER_BULK_SEND_PER_TICK);
+    }
 
     mails = mailsCount;
 
     // 50 msecs is tick length
-    needTime = 50 * mailsCount / sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK) / IN_MILLISECONDS;
+    needTime = 50 * ticksCount / IN_MILLISECONDS;
 }
 
 
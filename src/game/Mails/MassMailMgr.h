@@ -112,6 +112,9 @@ class MassMailMgr
 
         typedef std::list<MassMail> MassMailList;
 
+        /// Send up to maxcount mails of task without items, mails to offline characters are stored in bulk. Returns amount of mails sent.
+        uint32 UpdateBulk(MassMail& task, uint32 maxcount);
+
         /// List of current queued mass mail tasks
         MassMailList m_massMails;
 };
@@ -23,6 +23,7 @@
 #include "Server/DBCStores.h"
 #include "Maps/GridMap.h"
 #include "VMapFactory.h"
+#include "MapTree.h"
 #include "MotionGenerators/MoveMap.h"
 #include "World/World.h"
 #include "Policies/Singleton.h"
@@ -715,6 +716,9 @@ TerrainInfo::~TerrainInfo()
         for (auto& m_GridMap : m_GridMaps)
             delete m_GridMap[k];
 
+    for (auto& prefetched : m_prefetchedGridMaps)
+        delete prefetched.second.map;
+
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
 }
@@ -782,6 +786,26 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
         }
     }
 
+    {
+        // drop grids prefetched for nothing, taxi may have turned
+        LOCK_GUARD lock(m_mutex);
+        for (PrefetchedGridMaps::iterator itr = m_prefetchedGridMaps.begin(); itr != m_prefetchedGridMaps.end();)
+        {
+            if (itr->second.map && itr->second.unused)
+            {
+                delete itr->second.map;
+                itr = m_prefetchedGridMaps.erase(itr);
+                continue;
+            }
+
+            if (itr->second.map)
+                itr->second.unused = true;
+            ++itr;
+        }
+    }
+
+    MMAP::MMapFactory::createOrGetMMapManager()->dropUnusedPrefetchedTiles(m_mapId);
+
     i_timer.Reset();
 }
 
@@ -1135,6 +1159,18 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
 
     {
         LOCK_GUARD lock(m_mutex);
+
+        // grid read ahead by prefetch thread, if it is still reading the result will be dropped
+        PrefetchedGridMaps::iterator prefetched = m_prefetchedGridMaps.find(x << 16 | y);
+        if (prefetched != m_prefetchedGridMaps.end())
+        {
+            if (!m_GridMaps[x][y])
+                m_GridMaps[x][y] = prefetched->second.map;
+            else
+                delete prefetched->second.map;
+            m_prefetchedGridMaps.erase(prefetched);
+        }
+
         // double checked lock pattern
         if (!m_GridMaps[x][y])
         {
@@ -1194,6 +1230,67 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
     return  m_GridMaps[x][y];
 }
 
+void TerrainInfo::Prefetch(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    {
+        LOCK_GUARD lock(m_mutex);
+        if (m_GridMaps[x][y])
+            return;
+
+        // already requested
+        if (!m_prefetchedGridMaps.insert(PrefetchedGridMaps::value_type(x << 16 | y, PrefetchedGridMap())).second)
+            return;
+    }
+
+    sTerrainMgr.PrefetchGrid(this, x, y);
+}
+
+// called by terrain prefetch thread
+void TerrainInfo::LoadPrefetched(const uint32 x, const uint32 y)
+{
+    GridMap* map = new GridMap();
+
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Prefetching map %s", tmp);
+
+    // errors are reported by regular load
+    if (!map->loadData(tmp))
+    {
+        delete map;
+        map = nullptr;
+    }
+    delete[] tmp;
+
+    // vmap manager is not thread safe, only read tile file so that map update finds it in file cache
+    std::string vmapTile = sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(m_mapId, x, y);
+    if (FILE* file = fopen(vmapTile.c_str(), "rb"))
+    {
+        char buffer[16 * 1024];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer)) {}
+        fclose(file);
+    }
+
+    MMAP::MMapFactory::createOrGetMMapManager()->prefetchTile(m_mapId, x, y);
+
+    LOCK_GUARD lock(m_mutex);
+    PrefetchedGridMaps::iterator itr = m_prefetchedGridMaps.find(x << 16 | y);
+    if (itr == m_prefetchedGridMaps.end() || !map)
+    {
+        // already loaded meanwhile or nothing to keep
+        if (itr != m_prefetchedGridMaps.end())
+            m_prefetchedGridMaps.erase(itr);
+        delete map;
+        return;
+    }
+
+    itr->second.map = map;
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= nullptr*/) const
 {
     if (const_cast<TerrainInfo*>(this)->GetGrid(x, y))
@@ -1221,12 +1318,14 @@ float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= n
 INSTANTIATE_SINGLETON_2(TerrainManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(TerrainManager, std::mutex);
 
-TerrainManager::TerrainManager()
+TerrainManager::TerrainManager() : m_prefetchStopping(false)
 {
 }
 
 TerrainManager::~TerrainManager()
 {
+    StopPrefetch();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 }
@@ -1274,12 +1373,65 @@ void TerrainManager::Update(const uint32 diff)
 
 void TerrainManager::UnloadAll()
 {
+    StopPrefetch();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 
     i_TerrainMap.clear();
 }
 
+void TerrainManager::PrefetchGrid(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    std::lock_guard<std::mutex> guard(m_prefetchLock);
+    if (m_prefetchStopping)
+        return;
+
+    if (!m_prefetchThread.joinable())
+        m_prefetchThread = std::thread(&TerrainManager::PrefetchThread, this);
+
+    // keep terrain alive until its grid is read
+    terrain->AddRef();
+    m_prefetchQueue.push_back(PrefetchQueue::value_type(terrain, x << 16 | y));
+    m_prefetchCondition.notify_one();
+}
+
+void TerrainManager::PrefetchThread()
+{
+    std::unique_lock<std::mutex> guard(m_prefetchLock);
+    for (;;)
+    {
+        m_prefetchCondition.wait(guard, [this] { return m_prefetchStopping || !m_prefetchQueue.empty(); });
+        if (m_prefetchStopping)
+            return;
+
+        PrefetchQueue::value_type request = m_prefetchQueue.front();
+        m_prefetchQueue.pop_front();
+        guard.unlock();
+
+        request.first->LoadPrefetched(request.second >> 16, request.second & 0xFFFF);
+        request.first->Release();
+
+        guard.lock();
+    }
+}
+
+void TerrainManager::StopPrefetch()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        m_prefetchStopping = true;
+    }
+    m_prefetchCondition.notify_all();
+
+    if (m_prefetchThread.joinable())
+        m_prefetchThread.join();
+
+    for (auto& request : m_prefetchQueue)
+        request.first->Release();
+    m_prefetchQueue.clear();
+}
+
 uint32 TerrainManager::GetAreaIdByAreaFlag(uint16 areaflag, uint32 map_id)
 {
     AreaTableEntry const* entry = GetAreaEntryByAreaFlagAndMap(areaflag, map_id);
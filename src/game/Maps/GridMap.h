@@ -26,7 +26,10 @@
 #include "Maps/GridMapDefines.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 
 class Creature;
 class Unit;
@@ -177,10 +180,15 @@ class TerrainInfo : public Referencable<std::atomic_long>
     protected:
         friend class Map;
         friend class ObjectMgr;
+        friend class TerrainManager;
         // load/unload terrain data
         GridMap* Load(const uint32 x, const uint32 y, bool mapOnly = false);
         void Unload(const uint32 x, const uint32 y);
 
+        // read terrain data of grid expected to be loaded soon in background
+        void Prefetch(const uint32 x, const uint32 y);
+        void LoadPrefetched(const uint32 x, const uint32 y);
+
     private:
         TerrainInfo(const TerrainInfo&);
         TerrainInfo& operator=(const TerrainInfo&);
@@ -203,6 +211,16 @@ class TerrainInfo : public Referencable<std::atomic_long>
         typedef std::lock_guard<LOCK_TYPE> LOCK_GUARD;
         LOCK_TYPE m_mutex;
         LOCK_TYPE m_refMutex;
+
+        struct PrefetchedGridMap
+        {
+            PrefetchedGridMap() : map(nullptr), unused(false) {}
+
+            GridMap* map;                                   // nullptr while still loading
+            bool unused;                                    // not taken by Load since last CleanUpGrids
+        };
+        typedef std::unordered_map<uint32, PrefetchedGridMap> PrefetchedGridMaps;
+        PrefetchedGridMaps m_prefetchedGridMaps;            // guarded by m_mutex
 };
 
 // class for managing TerrainData object and all sort of geometry querying operations
@@ -218,6 +236,9 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         void Update(const uint32 diff);
         void UnloadAll();
 
+        // queue terrain grid read for terrain prefetch thread
+        void PrefetchGrid(TerrainInfo* terrain, uint32 x, uint32 y);
+
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
             TerrainInfo* pData = const_cast<TerrainManager*>(this)->LoadTerrain(mapid);
@@ -247,8 +268,18 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         TerrainManager(const TerrainManager&);
         TerrainManager& operator=(const TerrainManager&);
 
+        void PrefetchThread();
+        void StopPrefetch();
+
         typedef MaNGOS::ClassLevelLockable<TerrainManager, std::mutex>::Lock Guard;
         TerrainDataMap i_TerrainMap;
+
+        typedef std::deque<std::pair<TerrainInfo*, uint32> > PrefetchQueue;
+        std::thread m_prefetchThread;
+        std::mutex m_prefetchLock;
+        std::condition_variable m_prefetchCondition;
+        PrefetchQueue m_prefetchQueue;                      // terrain and packed grid coords, terrain referenced while queued
+        bool m_prefetchStopping;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
@@ -34,6 +34,7 @@
 #include "Maps/MapPersistentStateMgr.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/WaypointMovementGenerator.h"
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "Grids/ObjectGridLoader.h"
@@ -94,9 +95,12 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0),
-      m_cycleCounter(0), m_updateTimeMin(INT_MAX), m_updateTimeMax(0), m_updateTimeTotal(0)
+      m_cycleCounter(0), m_updateTimeMin(INT_MAX), m_updateTimeMax(0), m_updateTimeTotal(0),
+      m_updateArenaBytesLast(0), m_updateArenaBytesMax(0), m_updateLodSkippedLast(0)
 {
     m_weatherSystem = new WeatherSystem(this);
+    m_gridPrefetchTimer.SetInterval(1 * IN_MILLISECONDS);
+    InitUpdateLod();
 }
 
 void Map::Initialize(bool loadInstanceData /*= true*/)
@@ -248,6 +252,58 @@ void Map::EnsureGridCreated(const GridPair& p)
     }
 }
 
+void Map::PrefetchGrids(const uint32& diff)
+{
+    uint32 lookAhead = sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_TIME);
+    if (!lookAhead)
+        return;
+
+    m_gridPrefetchTimer.Update(diff);
+    if (!m_gridPrefetchTimer.Passed())
+        return;
+    m_gridPrefetchTimer.Reset();
+
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* plr = m_mapRefIter->getSource();
+        if (!plr || !plr->IsInWorld())
+            continue;
+
+        bool taxi = plr->IsTaxiFlying();
+        if (!taxi && !plr->IsMoving())
+            continue;
+
+        // expect player to keep its direction
+        float dist = (taxi ? PLAYER_FLIGHT_SPEED : plr->GetSpeed(MOVE_RUN)) * lookAhead;
+        float x = plr->GetPositionX() + dist * cos(plr->GetOrientation());
+        float y = plr->GetPositionY() + dist * sin(plr->GetOrientation());
+
+        // grids which will be loaded when player gets there
+        float x1 = x - GetVisibilityDistance(), x2 = x + GetVisibilityDistance();
+        float y1 = y - GetVisibilityDistance(), y2 = y + GetVisibilityDistance();
+        MaNGOS::NormalizeMapCoord(x1);
+        MaNGOS::NormalizeMapCoord(x2);
+        MaNGOS::NormalizeMapCoord(y1);
+        MaNGOS::NormalizeMapCoord(y2);
+
+        GridPair p1 = MaNGOS::ComputeGridPair(x1, y1);
+        GridPair p2 = MaNGOS::ComputeGridPair(x2, y2);
+
+        for (uint32 gridX = std::min(p1.x_coord, p2.x_coord); gridX <= std::max(p1.x_coord, p2.x_coord); ++gridX)
+        {
+            for (uint32 gridY = std::min(p1.y_coord, p2.y_coord); gridY <= std::max(p1.y_coord, p2.y_coord); ++gridY)
+            {
+                // z coord
+                int gx = (MAX_NUMBER_OF_GRIDS - 1) - gridX;
+                int gy = (MAX_NUMBER_OF_GRIDS - 1) - gridY;
+
+                if (!m_bLoadedGrids[gx][gy])
+                    m_TerrainData->Prefetch(gx, gy);
+            }
+        }
+    }
+}
+
 void Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
 {
     NGridType* grid;
@@ -580,10 +636,87 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
     }
 }
 
+void Map::InitUpdateLod()
+{
+    if (IsBattleGround())
+    {
+        m_updateLodInnerDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_INNER_BG);
+        m_updateLodOuterDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_OUTER_BG);
+    }
+    else if (IsDungeon())
+    {
+        m_updateLodInnerDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_INNER_INSTANCES);
+        m_updateLodOuterDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_OUTER_INSTANCES);
+    }
+    else
+    {
+        m_updateLodInnerDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_INNER_CONTINENTS);
+        m_updateLodOuterDistance = sWorld.getConfig(CONFIG_FLOAT_UPDATE_LOD_OUTER_CONTINENTS);
+    }
+
+    m_updateLodOuterDistance = std::max(m_updateLodOuterDistance, m_updateLodInnerDistance);
+
+    m_updateLodIntervals[UPDATE_LOD_INNER] = 1;
+    m_updateLodIntervals[UPDATE_LOD_MIDDLE] = sWorld.getConfig(CONFIG_UINT32_UPDATE_LOD_INTERVAL_MIDDLE);
+    m_updateLodIntervals[UPDATE_LOD_OUTER] = std::max(sWorld.getConfig(CONFIG_UINT32_UPDATE_LOD_INTERVAL_OUTER), m_updateLodIntervals[UPDATE_LOD_MIDDLE]);
+    m_updateLodTick = 0;
+}
+
+void Map::AddUpdateLodViewer(WorldObject const* viewer, UpdateLodCellRings& cellRings) const
+{
+    // viewer position in cell units, cell (x, y) covers [x, x + 1) * [y, y + 1)
+    float const vx = (viewer->GetPositionX() - CENTER_GRID_CELL_OFFSET) / SIZE_OF_GRID_CELL + CENTER_GRID_CELL_ID + 0.5f;
+    float const vy = (viewer->GetPositionY() - CENTER_GRID_CELL_OFFSET) / SIZE_OF_GRID_CELL + CENTER_GRID_CELL_ID + 0.5f;
+
+    float const innerDist = m_updateLodInnerDistance / SIZE_OF_GRID_CELL;
+    float const outerDist = m_updateLodOuterDistance / SIZE_OF_GRID_CELL;
+
+    // same cells as visited by VisitNearbyCellsOf
+    CellArea area = Cell::CalculateCellArea(viewer->GetPositionX(), viewer->GetPositionY(), GetVisibilityDistance());
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            // nearest point of the cell, any creature in it is at least that far
+            float const dx = std::max(0.0f, std::max(float(x) - vx, vx - float(x + 1)));
+            float const dy = std::max(0.0f, std::max(float(y) - vy, vy - float(y + 1)));
+            float const distSq = dx * dx + dy * dy;
+
+            uint8 ring = UPDATE_LOD_OUTER;
+            if (distSq < innerDist * innerDist)
+                ring = UPDATE_LOD_INNER;
+            else if (distSq < outerDist * outerDist)
+                ring = UPDATE_LOD_MIDDLE;
+
+            auto result = cellRings.emplace((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x, ring);
+            if (!result.second && ring < result.first->second)
+                result.first->second = ring;
+        }
+    }
+}
+
+uint32 Map::GetUpdateLodInterval(Creature const* creature, UpdateLodCellRings const& cellRings) const
+{
+    // fights and player controlled creatures are always updated at full rate
+    if (creature->isInCombat() || creature->IsPet() || creature->GetMasterGuid().IsPlayer())
+        return 1;
+
+    CellPair p = MaNGOS::ComputeCellPair(creature->GetPositionX(), creature->GetPositionY());
+    auto itr = cellRings.find((p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + p.x_coord);
+    if (itr == cellRings.end())                  // moved in this tick to not visited cell
+        return 1;
+
+    return m_updateLodIntervals[itr->second];
+}
+
 void Map::Update(const uint32& t_diff)
 {
     std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
 
+    // per tick temporaries of this update are released together at its end
+    FrameArenaScope updateArena;
+
     m_dyn_tree.update(t_diff);
 
     /// update worldsessions for existing players
@@ -607,6 +740,8 @@ void Map::Update(const uint32& t_diff)
             plr->Update(t_diff);
     }
 
+    PrefetchGrids(t_diff);
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -618,6 +753,11 @@ void Map::Update(const uint32& t_diff)
         m_messageVector.clear();
     }
 
+    // nearest viewer ring of visited cells, collected together with the cells visit
+    bool const updateLod = m_updateLodInnerDistance > 0.0f;
+    UpdateLodCellRings cellRings;
+    ++m_updateLodTick;
+
     WorldObjectUnSet objToUpdate;
     MaNGOS::ObjectUpdater obj_updater(objToUpdate);
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
@@ -632,10 +772,16 @@ void Map::Update(const uint32& t_diff)
             continue;
 
         VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        if (updateLod)
+            AddUpdateLodViewer(player, cellRings);
 
         // If player is using far sight, visit that object too
         if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+        {
             VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+            if (updateLod)
+                AddUpdateLodViewer(viewPoint, cellRings);
+        }
     }
 
     // non-player active objects
@@ -653,6 +799,9 @@ void Map::Update(const uint32& t_diff)
             if (!obj->IsInWorld() || !obj->IsPositionValid())
                 continue;
 
+            if (updateLod)
+                AddUpdateLodViewer(obj, cellRings);
+
             // lets update mobs/objects in ALL visible cells around player!
             CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
 
@@ -678,8 +827,26 @@ void Map::Update(const uint32& t_diff)
     }
 
     // update all objects
+    uint32 lodSkipped = 0;
     for (auto wObj : objToUpdate)
+    {
+        if (updateLod && wObj->GetTypeId() == TYPEID_UNIT)
+        {
+            Creature* creature = static_cast<Creature*>(wObj);
+            uint32 diff;
+            if (!creature->TakeLodUpdateDiff(t_diff, GetUpdateLodInterval(creature, cellRings), m_updateLodTick, diff))
+            {
+                ++lodSkipped;
+                continue;
+            }
+
+            creature->Update(diff);
+            continue;
+        }
+
         wObj->Update(t_diff);
+    }
+    m_updateLodSkippedLast = lodSkipped;
 
     // Send world objects and item update field changes
     SendObjectUpdates();
@@ -718,6 +885,11 @@ void Map::Update(const uint32& t_diff)
     ++m_cycleCounter;
 
     m_weatherSystem->UpdateWeathers(t_diff);
+
+    uint32 arenaBytes = uint32(updateArena.GetArena().GetUsedBytes());
+    m_updateArenaBytesLast = arenaBytes;
+    if (arenaBytes > m_updateArenaBytesMax)
+        m_updateArenaBytesMax = arenaBytes;
 }
 
 void Map::Remove(Player* player, bool remove)
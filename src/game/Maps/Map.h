@@ -159,6 +159,13 @@ class Map : public GridRefManager<NGridType>
             return loaded(p);
         }
 
+        bool IsActiveGrid(float x, float y) const
+        {
+            GridPair p = MaNGOS::ComputeGridPair(x, y);
+            NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+            return grid && grid->GetGridState() == GRID_STATE_ACTIVE;
+        }
+
         bool GetUnloadLock(const GridPair& p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(const GridPair& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void ForceLoadGrid(float x, float y);
@@ -207,6 +214,12 @@ class Map : public GridRefManager<NGridType>
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
 
+        // update level of detail: creatures far from all players and active objects are updated every few ticks
+        typedef std::unordered_map<uint32, uint8, std::hash<uint32>, std::equal_to<uint32>, FrameArenaAllocator<std::pair<const uint32, uint8> > > UpdateLodCellRings;
+        void InitUpdateLod();
+        void AddUpdateLodViewer(WorldObject const* viewer, UpdateLodCellRings& cellRings) const;
+        uint32 GetUpdateLodInterval(Creature const* creature, UpdateLodCellRings const& cellRings) const;
+
         /// Send a Packet to all players on a map
         void SendToPlayers(WorldPacket const& data) const;
         /// Send a Packet to all players in a zone. Return false if no player found
@@ -318,6 +331,9 @@ class Map : public GridRefManager<NGridType>
         uint32 GetUpdateTimeMin() { return m_updateTimeMin; }
         uint32 GetUpdateTimeMax() { return m_updateTimeMax; }
         uint32 GetUpdateTimeAvg() { return uint32(m_updateTimeTotal / m_cycleCounter); }
+        uint32 GetUpdateArenaBytesLast() const { return m_updateArenaBytesLast; }
+        uint32 GetUpdateArenaBytesMax() const { return m_updateArenaBytesMax; }
+        uint32 GetUpdateLodSkippedLast() const { return m_updateLodSkippedLast; }
 
         uint32 GetCurrentMSTime() const;
         TimePoint GetCurrentClockTime() const;
@@ -362,6 +378,9 @@ class Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
         std::set<Object*> i_objectsToClientUpdate;
 
+        // request background read of terrain of grids ahead of moving players
+        void PrefetchGrids(const uint32& diff);
+
     protected:
         MapEntry const* i_mapEntry;
         uint32 i_id;
@@ -394,9 +413,23 @@ class Map : public GridRefManager<NGridType>
         // Shared geodata object with map coord info...
         TerrainInfo* const m_TerrainData;
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        ShortIntervalTimer m_gridPrefetchTimer;
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
+        enum UpdateLodRing
+        {
+            UPDATE_LOD_INNER    = 0,                        // always updated
+            UPDATE_LOD_MIDDLE   = 1,
+            UPDATE_LOD_OUTER    = 2,
+            MAX_UPDATE_LOD_RINGS
+        };
+
+        float m_updateLodInnerDistance;                     // 0 if disabled for the map
+        float m_updateLodOuterDistance;
+        uint32 m_updateLodIntervals[MAX_UPDATE_LOD_RINGS];  // in map ticks
+        uint32 m_updateLodTick;
+
         WorldObjectSet i_objectsToRemove;
 
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
@@ -433,6 +466,9 @@ class Map : public GridRefManager<NGridType>
         std::atomic<uint32> m_updateTimeMin;
         std::atomic<uint32> m_updateTimeMax;
         std::atomic<uint64> m_updateTimeTotal;
+        std::atomic<uint32> m_updateArenaBytesLast;         // frame arena used by one update
+        std::atomic<uint32> m_updateArenaBytesMax;
+        std::atomic<uint32> m_updateLodSkippedLast;         // creature updates skipped by last update
 };
 
 class WorldMap : public Map
@@ -35,6 +35,7 @@
 
 #include <list>
 #include <cstdarg>
+#include <sstream>
 
 INSTANTIATE_SINGLETON_1(MapPersistentStateManager);
 
@@ -52,6 +53,7 @@ MapPersistentState::MapPersistentState(uint16 MapId, uint32 InstanceId)
 
 MapPersistentState::~MapPersistentState()
 {
+    SaveRespawnTimesToDB();
 }
 
 MapEntry const* MapPersistentState::GetMapEntry() const
@@ -72,52 +74,97 @@ bool MapPersistentState::UnloadIfEmpty()
 
 void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
 {
-    SetCreatureRespawnTime(loguid, t);
-
     // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGround())
-        return;
-
-    CharacterDatabase.BeginTransaction();
+    if (!GetMapEntry()->IsBattleGround())
+    {
+        m_pendingCreatureRespawnTimes[loguid] = t;
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+        // without save interval keep old behaviour and write at once
+        if (!sWorld.getConfig(CONFIG_UINT32_RESPAWN_SAVE_INTERVAL))
+            SaveRespawnTimesToDB();
+    }
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM creature_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+    SetCreatureRespawnTime(loguid, t);                      // state can be deleted at call, pending data saved in destructor
+}
 
-    if (t > sWorld.GetGameTime())
+void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+{
+    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
+    if (!GetMapEntry()->IsBattleGround())
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO creature_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
+        m_pendingGORespawnTimes[loguid] = t;
+
+        // without save interval keep old behaviour and write at once
+        if (!sWorld.getConfig(CONFIG_UINT32_RESPAWN_SAVE_INTERVAL))
+            SaveRespawnTimesToDB();
     }
 
-    CharacterDatabase.CommitTransaction();
+    SetGORespawnTime(loguid, t);                            // state can be deleted at call, pending data saved in destructor
 }
 
-void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
+void MapPersistentState::SaveRespawnTimesToDB()
 {
-    SetGORespawnTime(loguid, t);
-
-    // BGs/Arenas always reset at server restart/unload, so no reason store in DB
-    if (GetMapEntry()->IsBattleGround())
+    if (m_pendingCreatureRespawnTimes.empty() && m_pendingGORespawnTimes.empty())
         return;
 
     CharacterDatabase.BeginTransaction();
+    SaveRespawnTimesToDB("creature_respawn", m_pendingCreatureRespawnTimes);
+    SaveRespawnTimesToDB("gameobject_respawn", m_pendingGORespawnTimes);
+    CharacterDatabase.CommitTransaction();
 
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
+    m_pendingCreatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
+}
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM gameobject_respawn WHERE guid = ? AND instance = ?");
-    stmt.PExecute(loguid, m_instanceid);
+void MapPersistentState::SaveRespawnTimesToDB(char const* table, RespawnTimes& pendingTimes) const
+{
+    // rows per statement, keep statements well below max_allowed_packet
+    static uint32 const batchSize = 500;
 
-    if (t > sWorld.GetGameTime())
+    time_t now = sWorld.GetGameTime();
+
+    std::ostringstream delStmt;
+    std::ostringstream insStmt;
+    uint32 delCount = 0;
+    uint32 insCount = 0;
+
+    for (RespawnTimes::const_iterator itr = pendingTimes.begin(); itr != pendingTimes.end();)
     {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO gameobject_respawn VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
-    }
+        if (!delCount)
+            delStmt << "DELETE FROM " << table << " WHERE instance = " << m_instanceid << " AND guid IN (" << itr->first;
+        else
+            delStmt << "," << itr->first;
+        ++delCount;
 
-    CharacterDatabase.CommitTransaction();
+        // expired or reset respawn times are only deleted
+        if (itr->second > now)
+        {
+            if (!insCount)
+                insStmt << "INSERT INTO " << table << " (guid, respawntime, instance) VALUES ";
+            else
+                insStmt << ",";
+            insStmt << "(" << itr->first << "," << uint64(itr->second) << "," << m_instanceid << ")";
+            ++insCount;
+        }
+
+        bool last = ++itr == pendingTimes.end();
+
+        // deletes of a chunk must be queued before its inserts
+        if (delCount >= batchSize || last)
+        {
+            delStmt << ")";
+            CharacterDatabase.Execute(delStmt.str().c_str());
+            delStmt.str("");
+            delCount = 0;
+
+            if (insCount)
+            {
+                CharacterDatabase.Execute(insStmt.str().c_str());
+                insStmt.str("");
+                insCount = 0;
+            }
+        }
+    }
 }
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
@@ -146,6 +193,8 @@ void MapPersistentState::ClearRespawnTimes()
 {
     m_goRespawnTimes.clear();
     m_creatureRespawnTimes.clear();
+    m_pendingGORespawnTimes.clear();
+    m_pendingCreatureRespawnTimes.clear();
 
     UnloadIfEmpty();
 }
@@ -687,6 +736,14 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
     }
 }
 
+void MapPersistentStateManager::SaveRespawnTimesToDB()
+{
+    for (auto& itr : m_instanceSaveByInstanceId)
+        itr.second->SaveRespawnTimesToDB();
+    for (auto& itr : m_instanceSaveByMapId)
+        itr.second->SaveRespawnTimesToDB();
+}
+
 void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 instanceId)
 {
     if (lock_instLists)
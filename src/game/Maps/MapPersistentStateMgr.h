@@ -93,6 +93,8 @@ class MapPersistentState
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
         void SaveGORespawnTime(uint32 loguid, time_t t);
+        // write respawn times buffered by Save*RespawnTime calls since last flush
+        void SaveRespawnTimesToDB();
 
         // pool system
         void InitPools();
@@ -121,6 +123,8 @@ class MapPersistentState
     private:
         typedef std::unordered_map<uint32, time_t> RespawnTimes;
 
+        void SaveRespawnTimesToDB(char const* table, RespawnTimes& pendingTimes) const;
+
         uint32 m_instanceid;
         uint32 m_mapid;
         Map* m_usedByMap;                                   // nullptr if map not loaded, non-nullptr lock MapPersistentState from unload
@@ -128,6 +132,8 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        RespawnTimes m_pendingCreatureRespawnTimes;         // changed since last SaveRespawnTimesToDB, coalesced per guid
+        RespawnTimes m_pendingGORespawnTimes;               // changed since last SaveRespawnTimesToDB, coalesced per guid
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 
         SpawnedPoolData m_spawnedPoolData;                  // Pools spawns state for map copy
@@ -345,6 +351,9 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
 
         void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
 
+        // flush buffered respawn times of all states, called periodically and at shutdown
+        void SaveRespawnTimesToDB();
+
         void Update() { m_Scheduler.Update(); }
     private:
         typedef std::unordered_map < uint32 /*InstanceId or MapId*/, MapPersistentState* > PersistentStateMap;
@@ -44,10 +44,21 @@ void FleeingMovementGenerator<T>::_setTargetLocation(T& owner)
 
     owner.addUnitState(UNIT_STAT_FLEEING_MOVE);
 
-    PathFinder path(&owner);
-    path.setPathLengthLimit(30.0f);
-    path.calculate(x, y, z);
-    if (path.getPathType() & PATHFIND_NOPATH)
+    // queued calculation is left to path finder worker, its result is not needed anymore
+    i_path = std::make_shared<PathFinder>(&owner);
+    i_path->setPathLengthLimit(30.0f);
+
+    // spline is launched when path finder worker result is picked up
+    if (!i_path->calculateAsync(x, y, z))
+        return;
+
+    _launchPath(owner);
+}
+
+template<class T>
+void FleeingMovementGenerator<T>::_launchPath(T& owner)
+{
+    if (i_path->getPathType() & PATHFIND_NOPATH)
     {
         // path not found recheck later
         i_nextCheckTime.Reset(50);
@@ -55,7 +66,7 @@ void FleeingMovementGenerator<T>::_setTargetLocation(T& owner)
     }
 
     Movement::MoveSplineInit init(owner);
-    init.MovebyPath(path.getPath());
+    init.MovebyPath(i_path->getPath());
     init.SetWalk(false);
     int32 traveltime = init.Launch();
     i_nextCheckTime.Reset(traveltime + urand(800, 1500));
@@ -159,6 +170,13 @@ bool FleeingMovementGenerator<T>::Update(T& owner, const uint32& time_diff)
         return true;
     }
 
+    if (i_path && i_path->isQueued())
+    {
+        if (i_path->popResult())
+            _launchPath(owner);
+        return true;
+    }
+
     i_nextCheckTime.Update(time_diff);
     if (i_nextCheckTime.Passed() && owner.movespline->Finalized())
         _setTargetLocation(owner);
@@ -172,6 +190,8 @@ template bool FleeingMovementGenerator<Player>::_getPoint(Player&, float&, float
 template bool FleeingMovementGenerator<Creature>::_getPoint(Creature&, float&, float&, float&);
 template void FleeingMovementGenerator<Player>::_setTargetLocation(Player&);
 template void FleeingMovementGenerator<Creature>::_setTargetLocation(Creature&);
+template void FleeingMovementGenerator<Player>::_launchPath(Player&);
+template void FleeingMovementGenerator<Creature>::_launchPath(Creature&);
 template void FleeingMovementGenerator<Player>::Interrupt(Player&);
 template void FleeingMovementGenerator<Creature>::Interrupt(Creature&);
 template void FleeingMovementGenerator<Player>::Reset(Player&);
@@ -22,6 +22,10 @@
 #include "MovementGenerator.h"
 #include "Entities/ObjectGuid.h"
 
+#include <memory>
+
+class PathFinder;
+
 template<class T>
 class FleeingMovementGenerator
     : public MovementGeneratorMedium< T, FleeingMovementGenerator<T> >
@@ -39,10 +43,12 @@ class FleeingMovementGenerator
 
     private:
         void _setTargetLocation(T& owner);
+        void _launchPath(T& owner);
         bool _getPoint(T& owner, float& x, float& y, float& z);
 
         ObjectGuid i_frightGuid;
         TimeTracker i_nextCheckTime;
+        std::shared_ptr<PathFinder> i_path;                 // shared with path finder worker while queued
 };
 
 class TimedFleeingMovementGenerator
@@ -22,6 +22,13 @@
 #include "MoveMap.h"
 #include "MoveMapSharedDefines.h"
 
+#if PLATFORM != PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace MMAP
 {
     // ######################## MMapFactory ########################
@@ -118,6 +125,19 @@ namespace MMAP
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
+        if (m_prefetchThread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_prefetchLock);
+                m_prefetchStopping = true;
+            }
+            m_prefetchCondition.notify_all();
+            m_prefetchThread.join();
+        }
+
+        for (auto& prefetchedTile : m_prefetchedTiles)
+            prefetchedTile.second.tile.Release();
+
         for (auto& loadedMMap : loadedMMaps)
             delete loadedMMap.second;
 
@@ -165,9 +185,10 @@ namespace MMAP
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE));
         mmap_data->mmapLoadedTiles.clear();
 
+        std::lock_guard<std::mutex> guard(m_mapsLock);
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
         return true;
     }
@@ -213,6 +234,44 @@ namespace MMAP
         }
 
         // load this tile :: mmaps/MMMXXYY.mmtile
+        MMapTileData tile;
+        if (!takePrefetchedTile(mapId, packedGridPos, tile) && !readTile(mapId, x, y, tile, false))
+            return false;
+
+        dtMeshHeader* header = (dtMeshHeader*)tile.data;
+        dtTileRef tileRef = 0;
+
+        // tile data stays owned by us, it may be a file mapping
+        std::unique_lock<std::mutex> tileGuard(mmap->tileLock);
+        dtStatus dtResult = mmap->navMesh->addTile(tile.data, tile.size, 0, 0, &tileRef);
+        // cached corridors may reference the changed tile, drop them before workers query again
+        mmap->pathCache.Clear();
+        tileGuard.unlock();
+        if (dtStatusFailed(dtResult))
+        {
+            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
+            tile.Release();
+            return false;
+        }
+
+        mmap->mmapTileData[packedGridPos] = tile;
+        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        ++loadedTiles;
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+
+        // neighbour grids are likely next to become active
+        if (sWorld.getConfig(CONFIG_BOOL_MMAP_PREFETCH))
+        {
+            for (int32 i = x - 1; i <= x + 1; ++i)
+                for (int32 j = y - 1; j <= y + 1; ++j)
+                    if (i >= 0 && j >= 0 && i < MAX_NUMBER_OF_GRIDS && j < MAX_NUMBER_OF_GRIDS && !IsMMapIsLoaded(mapId, i, j))
+                        prefetchTile(mapId, i, j);
+        }
+        return true;
+    }
+
+    bool MMapManager::readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile, bool prefetch)
+    {
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile") + 1;
         char* fileName = new char[pathLen];
         snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
@@ -220,7 +279,8 @@ namespace MMAP
         FILE* file = fopen(fileName, "rb");
         if (!file)
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
+            if (!prefetch)
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
             delete[] fileName;
             return false;
         }
@@ -228,54 +288,201 @@ namespace MMAP
 
         // read header
         MmapTileHeader fileHeader;
-        fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
-
-        if (fileHeader.mmapMagic != MMAP_MAGIC)
+        if (fread(&fileHeader, sizeof(MmapTileHeader), 1, file) != 1 || fileHeader.mmapMagic != MMAP_MAGIC)
         {
-            sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            if (!prefetch)
+                sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
             return false;
         }
 
         if (fileHeader.mmapVersion != MMAP_VERSION)
         {
-            sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
-                          mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
+            if (!prefetch)
+                sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
+                              mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
             fclose(file);
             return false;
         }
 
+#if PLATFORM != PLATFORM_WINDOWS
+        // private mapping, detour writes tile links into the data but the file stays untouched
+        struct stat fileStat;
+        size_t mappingSize = sizeof(MmapTileHeader) + fileHeader.size;
+        if (fstat(fileno(file), &fileStat) == 0 && size_t(fileStat.st_size) >= mappingSize)
+        {
+            void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+            if (mapping != MAP_FAILED)
+            {
+                fclose(file);
+
+                tile.mapping = mapping;
+                tile.mappingSize = mappingSize;
+                tile.data = (unsigned char*)mapping + sizeof(MmapTileHeader);
+                tile.size = fileHeader.size;
+
+                // fault in all pages now, map update will find them in memory
+                if (prefetch)
+                {
+                    static const size_t pageSize = sysconf(_SC_PAGESIZE);
+                    volatile unsigned char sum = 0;
+                    for (size_t i = 0; i < mappingSize; i += pageSize)
+                        sum += ((unsigned char*)mapping)[i];
+                }
+                return true;
+            }
+        }
+#endif
+
         unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
         MANGOS_ASSERT(data);
 
         size_t result = fread(data, fileHeader.size, 1, file);
+        fclose(file);
         if (!result)
         {
-            sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            if (!prefetch)
+                sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+            dtFree(data);
             return false;
         }
 
-        fclose(file);
+        tile.data = data;
+        tile.size = fileHeader.size;
+        return true;
+    }
 
-        dtMeshHeader* header = (dtMeshHeader*)data;
-        dtTileRef tileRef = 0;
+    void MMapTileData::Release()
+    {
+#if PLATFORM != PLATFORM_WINDOWS
+        if (mapping)
+            munmap(mapping, mappingSize);
+        else
+#endif
+            dtFree(data);
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
-        if (dtStatusFailed(dtResult))
+        data = nullptr;
+        mapping = nullptr;
+    }
+
+    void MMapManager::prefetchTile(uint32 mapId, int32 x, int32 y)
+    {
+        // keep only limited amount of read ahead tiles in memory
+        static const uint32 MAX_PREFETCHED_TILES = 64;
+
+        uint64 key = (uint64(mapId) << 32) | packTileID(x, y);
+
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        if (m_prefetchedTiles.find(key) != m_prefetchedTiles.end() ||
+                std::find(m_prefetchQueue.begin(), m_prefetchQueue.end(), key) != m_prefetchQueue.end())
+            return;
+
+        if (m_prefetchQueue.size() + m_prefetchedTiles.size() >= MAX_PREFETCHED_TILES)
         {
-            sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
-            return false;
+            // newer requests are more likely to be loaded soon, make room by dropping oldest read tile
+            if (m_prefetchedTiles.empty())
+                return;
+
+            PrefetchedTileSet::iterator oldest = m_prefetchedTiles.begin();
+            for (PrefetchedTileSet::iterator itr = m_prefetchedTiles.begin(); itr != m_prefetchedTiles.end(); ++itr)
+                if (int32(itr->second.stamp - oldest->second.stamp) < 0)
+                    oldest = itr;
+
+            oldest->second.tile.Release();
+            m_prefetchedTiles.erase(oldest);
         }
 
-        mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-        ++loadedTiles;
-        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+        if (!m_prefetchThread.joinable())
+            m_prefetchThread = std::thread(&MMapManager::prefetchThread, this);
+
+        m_prefetchQueue.push_back(key);
+        m_prefetchCondition.notify_one();
+    }
+
+    bool MMapManager::takePrefetchedTile(uint32 mapId, uint32 packedGridPos, MMapTileData& tile)
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        PrefetchedTileSet::iterator itr = m_prefetchedTiles.find((uint64(mapId) << 32) | packedGridPos);
+        if (itr == m_prefetchedTiles.end())
+            return false;
+
+        tile = itr->second.tile;
+        m_prefetchedTiles.erase(itr);
         return true;
     }
 
+    void MMapManager::dropPrefetchedTiles(uint32 mapId)
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        for (PrefetchedTileSet::iterator itr = m_prefetchedTiles.begin(); itr != m_prefetchedTiles.end();)
+        {
+            if (uint32(itr->first >> 32) == mapId)
+            {
+                itr->second.tile.Release();
+                itr = m_prefetchedTiles.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    void MMapManager::dropUnusedPrefetchedTiles(uint32 mapId)
+    {
+        std::lock_guard<std::mutex> guard(m_prefetchLock);
+        for (PrefetchedTileSet::iterator itr = m_prefetchedTiles.begin(); itr != m_prefetchedTiles.end();)
+        {
+            if (uint32(itr->first >> 32) != mapId)
+            {
+                ++itr;
+                continue;
+            }
+
+            // mover may have turned away, don't keep the mapping until map unload
+            if (itr->second.unused)
+            {
+                itr->second.tile.Release();
+                itr = m_prefetchedTiles.erase(itr);
+                continue;
+            }
+
+            itr->second.unused = true;
+            ++itr;
+        }
+    }
+
+    void MMapManager::prefetchThread()
+    {
+        std::unique_lock<std::mutex> guard(m_prefetchLock);
+        for (;;)
+        {
+            m_prefetchCondition.wait(guard, [this] { return m_prefetchStopping || !m_prefetchQueue.empty(); });
+            if (m_prefetchStopping)
+                return;
+
+            uint64 key = m_prefetchQueue.front();
+            guard.unlock();
+
+            uint32 packedGridPos = uint32(key);
+            MMapTileData tile;
+            bool loaded = readTile(uint32(key >> 32), int32(packedGridPos >> 16), int32(packedGridPos & 0xFFFF), tile, true);
+
+            guard.lock();
+            m_prefetchQueue.pop_front();
+            if (!loaded)
+                continue;
+
+            PrefetchedTile& prefetched = m_prefetchedTiles[key];
+            if (prefetched.tile.data)
+            {
+                tile.Release();
+                continue;
+            }
+
+            prefetched.tile = tile;
+            prefetched.stamp = m_prefetchStamp++;
+        }
+    }
+
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
@@ -300,7 +507,11 @@ namespace MMAP
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
         // unload, and mark as non loaded
+        std::unique_lock<std::mutex> tileGuard(mmap->tileLock);
         dtStatus dtResult = mmap->navMesh->removeTile(tileRef, nullptr, nullptr);
+        // cached corridors may reference the changed tile, drop them before workers query again
+        mmap->pathCache.Clear();
+        tileGuard.unlock();
         if (dtStatusFailed(dtResult))
         {
             // this is technically a memory leak
@@ -311,6 +522,8 @@ namespace MMAP
         }
         else
         {
+            mmap->mmapTileData[packedGridPos].Release();
+            mmap->mmapTileData.erase(packedGridPos);
             mmap->mmapLoadedTiles.erase(packedGridPos);
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
@@ -331,6 +544,13 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = loadedMMaps[mapId];
+
+        // wait for path finder workers using this navmesh and prevent new lookups
+        std::unique_lock<std::mutex> mapsGuard(m_mapsLock);
+        std::unique_lock<std::mutex> tileGuard(mmap->tileLock);
+        loadedMMaps.erase(mapId);
+        mapsGuard.unlock();
+
         for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -345,8 +565,9 @@ namespace MMAP
             }
         }
 
+        tileGuard.unlock();
         delete mmap;
-        loadedMMaps.erase(mapId);
+        dropPrefetchedTiles(mapId);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
 
         return true;
@@ -386,6 +607,14 @@ namespace MMAP
         return loadedMMaps[mapId]->navMesh;
     }
 
+    NavMeshPathCache* MMapManager::GetPathCache(uint32 mapId)
+    {
+        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+            return nullptr;
+
+        return &loadedMMaps[mapId]->pathCache;
+    }
+
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         if (loadedMMaps.find(mapId) == loadedMMaps.end())
@@ -411,4 +640,109 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    dtNavMeshQuery const* MMapManager::GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId, std::unique_lock<std::mutex>& tileGuard)
+    {
+        std::lock_guard<std::mutex> mapsGuard(m_mapsLock);
+
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+            return nullptr;
+
+        MMapData* mmap = itr->second;
+        tileGuard = std::unique_lock<std::mutex>(mmap->tileLock);
+
+        NavMeshQuerySet::const_iterator queryItr = mmap->workerQueries.find(workerId);
+        if (queryItr != mmap->workerQueries.end())
+            return queryItr->second;
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+        dtStatus dtResult = query->init(mmap->navMesh, 1024);
+        if (dtStatusFailed(dtResult))
+        {
+            dtFreeNavMeshQuery(query);
+            tileGuard.unlock();
+            sLog.outError("MMAP:GetWorkerNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+            return nullptr;
+        }
+
+        DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetWorkerNavMeshQuery: created dtNavMeshQuery for mapId %03u worker %u", mapId, workerId);
+        mmap->workerQueries.insert(std::pair<uint32, dtNavMeshQuery*>(workerId, query));
+        return query;
+    }
+
+    // ######################## NavMeshPathCache ########################
+    uint64 NavMeshPathCache::MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags)
+    {
+        uint64 key = uint64(startPoly) * 0x9E3779B97F4A7C15ULL;
+        key ^= uint64(endPoly) + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+        key ^= uint64(filterFlags) + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+        return key;
+    }
+
+    bool NavMeshPathCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& pathLength)
+    {
+        if (!m_maxSize)
+            return false;
+
+        uint32 filterFlags = MakeFilterFlags(filter);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto itr = m_pathIndex.find(MakeKey(startPoly, endPoly, filterFlags));
+        if (itr == m_pathIndex.end())
+            return false;
+
+        CachedPath const& cached = *itr->second;
+        if (cached.startPoly != startPoly || cached.endPoly != endPoly || cached.filterFlags != filterFlags)
+            return false;
+
+        m_paths.splice(m_paths.begin(), m_paths, itr->second);
+
+        pathLength = cached.path.size();
+        memcpy(path, cached.path.data(), pathLength * sizeof(dtPolyRef));
+        return true;
+    }
+
+    void NavMeshPathCache::Add(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength)
+    {
+        if (!m_maxSize)
+            return;
+
+        uint32 filterFlags = MakeFilterFlags(filter);
+        uint64 key = MakeKey(startPoly, endPoly, filterFlags);
+
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto itr = m_pathIndex.find(key);
+        if (itr != m_pathIndex.end())
+            m_paths.splice(m_paths.begin(), m_paths, itr->second);
+        else
+        {
+            // reuse the least recently used entry when full
+            if (m_paths.size() >= m_maxSize)
+            {
+                m_pathIndex.erase(m_paths.back().key);
+                m_paths.splice(m_paths.begin(), m_paths, std::prev(m_paths.end()));
+            }
+            else
+                m_paths.emplace_front();
+
+            m_pathIndex[key] = m_paths.begin();
+        }
+
+        CachedPath& cached = m_paths.front();
+        cached.key = key;
+        cached.startPoly = startPoly;
+        cached.endPoly = endPoly;
+        cached.filterFlags = filterFlags;
+        cached.path.assign(path, path + pathLength);
+    }
+
+    void NavMeshPathCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_pathIndex.clear();
+        m_paths.clear();
+    }
 }
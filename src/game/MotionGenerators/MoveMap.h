@@ -20,6 +20,12 @@
 #define _MOVE_MAP_H
 
 #include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
@@ -43,24 +49,82 @@ namespace MMAP
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
+    // content of .mmtile file, private read only file mapping when platform supports it, dtAlloc'd buffer otherwise
+    // tiles are added without DT_TILE_FREE_DATA, so it is released by us after tile removal
+    struct MMapTileData
+    {
+        MMapTileData() : data(nullptr), size(0), mapping(nullptr), mappingSize(0) {}
+
+        void Release();
+
+        unsigned char* data;
+        uint32 size;
+        void* mapping;
+        size_t mappingSize;
+    };
+    typedef std::unordered_map<uint32, MMapTileData> MMapTileDataSet;
+
+    // recently found poly paths of one navmesh, least recently used one is dropped when full
+    // shared by all map instances and path finder workers
+    class NavMeshPathCache
+    {
+        public:
+            explicit NavMeshPathCache(uint32 maxSize) : m_maxSize(maxSize) {}
+
+            bool Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& pathLength);
+            void Add(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength);
+            void Clear();
+
+        private:
+            struct CachedPath
+            {
+                uint64 key;
+                dtPolyRef startPoly;
+                dtPolyRef endPoly;
+                uint32 filterFlags;
+                std::vector<dtPolyRef> path;
+            };
+            typedef std::list<CachedPath> CachedPathList;
+
+            static uint64 MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, uint32 filterFlags);
+            static uint32 MakeFilterFlags(dtQueryFilter const& filter) { return (uint32(filter.getIncludeFlags()) << 16) | filter.getExcludeFlags(); }
+
+            uint32 m_maxSize;
+            CachedPathList m_paths;                                     // most recently used first
+            std::unordered_map<uint64, CachedPathList::iterator> m_pathIndex;
+            std::mutex m_lock;
+    };
+
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh, uint32 pathCacheSize) : navMesh(mesh), pathCache(pathCacheSize) {}
         ~MMapData()
         {
             for (auto& navMeshQuerie : navMeshQueries)
                 dtFreeNavMeshQuery(navMeshQuerie.second);
 
+            for (auto& workerQuery : workerQueries)
+                dtFreeNavMeshQuery(workerQuery.second);
+
             if (navMesh)
                 dtFreeNavMesh(navMesh);
+
+            for (auto& tileData : mmapTileData)
+                tileData.second.Release();
         }
 
         dtNavMesh* navMesh;
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        NavMeshQuerySet workerQueries;      // path finder worker id to query, only used with tileLock held
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileDataSet mmapTileData;       // maps [map grid coords] to data of [dtTile]
+        NavMeshPathCache pathCache;         // poly refs are only valid until tiles change
+
+        // held by path finder workers while reading navMesh and by map update while adding/removing tiles
+        std::mutex tileLock;
     };
 
 
@@ -71,7 +135,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), m_prefetchStamp(0), m_prefetchStopping(false) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -80,9 +144,18 @@ namespace MMAP
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
             bool IsMMapIsLoaded(uint32 mapId, uint32 x, uint32 y) const;
 
+            // read tile file in background thread, loadMap of it will not wait for disk then
+            void prefetchTile(uint32 mapId, int32 x, int32 y);
+            // drop tiles of map not taken by loadMap since previous call, called on terrain grid cleanup
+            void dropUnusedPrefetchedTiles(uint32 mapId);
+
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
+            NavMeshPathCache* GetPathCache(uint32 mapId);
+
+            // query owned by path finder worker thread, navmesh tiles can't change while tileGuard is held
+            dtNavMeshQuery const* GetWorkerNavMeshQuery(uint32 mapId, uint32 workerId, std::unique_lock<std::mutex>& tileGuard);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
@@ -90,8 +163,33 @@ namespace MMAP
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
 
+            static bool readTile(uint32 mapId, int32 x, int32 y, MMapTileData& tile, bool prefetch);
+            bool takePrefetchedTile(uint32 mapId, uint32 packedGridPos, MMapTileData& tile);
+            void dropPrefetchedTiles(uint32 mapId);
+            void prefetchThread();
+
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+
+            // protects loadedMMaps changes against path finder worker lookups
+            std::mutex m_mapsLock;
+
+            struct PrefetchedTile
+            {
+                PrefetchedTile() : stamp(0), unused(false) {}
+
+                MMapTileData tile;
+                uint32 stamp;                               // read order, oldest is evicted first when full
+                bool unused;                                // not taken by loadMap since last grid cleanup
+            };
+            typedef std::unordered_map<uint64, PrefetchedTile> PrefetchedTileSet;
+            std::thread m_prefetchThread;
+            std::mutex m_prefetchLock;
+            std::condition_variable m_prefetchCondition;
+            std::deque<uint64> m_prefetchQueue;             // map id and packed grid coords
+            PrefetchedTileSet m_prefetchedTiles;            // read but not loaded into navmesh yet
+            uint32 m_prefetchStamp;
+            bool m_prefetchStopping;
     };
 
     // static class
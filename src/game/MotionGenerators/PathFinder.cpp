@@ -22,6 +22,7 @@
 #include "PathFinder.h"
 #include "Log.h"
 #include "World/World.h"
+#include "PathFinderQueue.h"
 
 #include <Detour/Include/DetourCommon.h>
 #include <Detour/Include/DetourMath.h>
@@ -30,7 +31,10 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(nullptr), m_navMeshQuery(nullptr)
+    m_corridorEndValid(false), m_sourceUnit(owner), m_sourceGuidLow(owner->GetGUIDLow()), m_sourceMapId(owner->GetMapId()), m_sourceTypeId(owner->GetTypeId()),
+    m_sourceCanFly(false), m_sourceCanSwim(false), m_terrainCached(false),
+    m_startSwimmable(false), m_endSwimmable(false), m_startUnderWater(false), m_endUnderWater(false),
+    m_requestState(PATH_REQUEST_NONE), m_navMesh(nullptr), m_navMeshQuery(nullptr), m_pathCache(nullptr)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -40,6 +44,7 @@ PathFinder::PathFinder(const Unit* owner) :
         MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
         m_navMesh = mmap->GetNavMesh(mapId);
         m_navMeshQuery = mmap->GetNavMeshQuery(mapId, m_sourceUnit->GetInstanceId());
+        m_pathCache = mmap->GetPathCache(mapId);
     }
 
     createFilter();
@@ -47,10 +52,81 @@ PathFinder::PathFinder(const Unit* owner) :
 
 PathFinder::~PathFinder()
 {
-    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceUnit->GetGUIDLow());
+    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathInfo() for %u \n", m_sourceGuidLow);
 }
 
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest)
+{
+    bool usePolyPath;
+    if (!preparePath(destX, destY, destZ, forceDest, usePolyPath))
+        return false;
+
+    if (usePolyPath)
+        BuildPolyPath(getStartPosition(), getEndPosition());
+
+    NormalizePath();
+    return true;
+}
+
+bool PathFinder::calculateAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    MANGOS_ASSERT(!isQueued());
+
+    bool usePolyPath;
+    if (!preparePath(destX, destY, destZ, forceDest, usePolyPath))
+        return true;
+
+    if (usePolyPath)
+    {
+        cacheTerrainInfo();
+
+        m_requestState = PATH_REQUEST_QUEUED;
+        if (sPathFinderQueue.Enqueue(shared_from_this()))
+            return false;
+
+        // no workers running, build in place
+        m_requestState = PATH_REQUEST_NONE;
+        m_terrainCached = false;
+        BuildPolyPath(getStartPosition(), getEndPosition());
+    }
+
+    NormalizePath();
+    return true;
+}
+
+void PathFinder::calculateQueued(dtNavMeshQuery const* query)
+{
+    // navmesh may also be reloaded since path preparation, poly refs of previous path are invalid then
+    if (query && query->getAttachedNavMesh() == m_navMesh)
+    {
+        // detour calls of this calculation use the worker query, map update one is not thread safe
+        dtNavMeshQuery const* mapQuery = m_navMeshQuery;
+        m_navMeshQuery = query;
+        BuildPolyPath(getStartPosition(), getEndPosition());
+        m_navMeshQuery = mapQuery;
+    }
+    else
+    {
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+    }
+
+    m_requestState = PATH_REQUEST_DONE;
+}
+
+bool PathFinder::popResult()
+{
+    if (m_requestState != PATH_REQUEST_DONE)
+        return false;
+
+    m_requestState = PATH_REQUEST_NONE;
+    m_terrainCached = false;
+
+    NormalizePath();
+    return true;
+}
+
+bool PathFinder::preparePath(float destX, float destY, float destZ, bool forceDest, bool& usePolyPath)
 {
     if (!MaNGOS::IsValidMapCoord(destX, destY, destZ))
         return false;
@@ -68,7 +144,7 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     m_forceDestination = forceDest;
 
-    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceUnit->GetGUIDLow());
+    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::calculate() for %u \n", m_sourceGuidLow);
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
@@ -77,15 +153,59 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
     {
         BuildShortcut();
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        usePolyPath = false;
         return true;
     }
 
     updateFilter();
 
-    BuildPolyPath(start, dest);
+    m_sourceCanFly = m_sourceUnit->CanFly();
+    m_sourceCanSwim = m_sourceUnit->CanSwim();
+
+    usePolyPath = true;
     return true;
 }
 
+void PathFinder::cacheTerrainInfo()
+{
+    m_terrainCached = true;
+    m_startSwimmable = m_endSwimmable = m_startUnderWater = m_endUnderWater = false;
+
+    // liquid checks only decide between swimming and flying shortcuts in BuildPolyPath
+    // result does not depend on them for units able to do both or none
+    if (m_sourceTypeId != TYPEID_PLAYER && m_sourceCanFly == m_sourceCanSwim)
+        return;
+
+    TerrainInfo const* terrain = m_sourceUnit->GetTerrain();
+    Vector3 const& start = getStartPosition();
+    Vector3 const& end = getEndPosition();
+
+    m_startSwimmable = terrain->IsSwimmable(start.x, start.y, start.z);
+    m_endSwimmable = terrain->IsSwimmable(end.x, end.y, end.z);
+
+    if (m_sourceTypeId == TYPEID_UNIT)
+    {
+        m_startUnderWater = terrain->IsUnderWater(start.x, start.y, start.z);
+        m_endUnderWater = terrain->IsUnderWater(end.x, end.y, end.z);
+    }
+}
+
+bool PathFinder::isSwimmable(const Vector3& p, bool isStart) const
+{
+    if (m_terrainCached)
+        return isStart ? m_startSwimmable : m_endSwimmable;
+
+    return m_sourceUnit->GetTerrain()->IsSwimmable(p.x, p.y, p.z);
+}
+
+bool PathFinder::isUnderWater(const Vector3& p, bool isStart) const
+{
+    if (m_terrainCached)
+        return isStart ? m_startUnderWater : m_endUnderWater;
+
+    return m_sourceUnit->GetTerrain()->IsUnderWater(p.x, p.y, p.z);
+}
+
 dtPolyRef PathFinder::getPathPolyByPosition(const dtPolyRef* polyPath, uint32 polyPathSize, const float* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -175,13 +295,13 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         BuildShortcut();
 
         // Check for swimming or flying shortcut
-        if ((startPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsSwimmable(startPos.x, startPos.y, startPos.z)) ||
-            (endPoly == INVALID_POLYREF && m_sourceUnit->GetTerrain()->IsSwimmable(endPos.x, endPos.y, endPos.z)))
-            m_type = m_sourceUnit->CanSwim() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+        if ((startPoly == INVALID_POLYREF && isSwimmable(startPos, true)) ||
+            (endPoly == INVALID_POLYREF && isSwimmable(endPos, false)))
+            m_type = m_sourceCanSwim ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
         else
         {
-            if (m_sourceUnit->GetTypeId() != TYPEID_PLAYER)
-                m_type = m_sourceUnit->CanFly() ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
+            if (m_sourceTypeId != TYPEID_PLAYER)
+                m_type = m_sourceCanFly ? PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH) : PATHFIND_NOPATH;
             else
                 m_type = PATHFIND_NOPATH;
         }
@@ -196,21 +316,19 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: farFromPoly distToStartPoly=%.3f distToEndPoly=%.3f\n", distToStartPoly, distToEndPoly);
 
         bool buildShotrcut = false;
-        if (m_sourceUnit->GetTypeId() == TYPEID_UNIT)
+        if (m_sourceTypeId == TYPEID_UNIT)
         {
-            Creature* owner = (Creature*)m_sourceUnit;
-
-            Vector3 p = (distToStartPoly > 7.0f) ? startPos : endPos;
-            if (m_sourceUnit->GetTerrain()->IsUnderWater(p.x, p.y, p.z))
+            bool isStart = distToStartPoly > 7.0f;
+            if (isUnderWater(isStart ? startPos : endPos, isStart))
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: underWater case\n");
-                if (owner->CanSwim())
+                if (m_sourceCanSwim)
                     buildShotrcut = true;
             }
             else
             {
                 DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: flying case\n");
-                if (owner->CanFly())
+                if (m_sourceCanFly)
                     buildShotrcut = true;
             }
         }
@@ -244,6 +362,8 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         m_pathPolyRefs[0] = startPoly;
         m_polyLength = 1;
+        m_corridorEndValid = true;
+        m_corridorEndPosition = Vector3(endPoint[2], endPoint[0], endPoint[1]);
 
         m_type = farFromPoly ? PATHFIND_INCOMPLETE : PATHFIND_NORMAL;
         DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: path type %d\n", m_type);
@@ -267,7 +387,7 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
                 sLog.outError("Invalid poly ref in BuildPolyPath. polyLength: %u, pathStartIndex: %u,"
                               " startPos: %s, endPos: %s, mapId: %u",
                               m_polyLength, pathStartIndex, startPos.toString().c_str(), endPos.toString().c_str(),
-                              m_sourceUnit->GetMapId());
+                              m_sourceMapId);
                 break;
             }
 
@@ -306,61 +426,69 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // we are moving on the old path but target moved out
         // so we have atleast part of poly-path ready
 
-        m_polyLength -= pathStartIndex;
+        // target usually moved only a bit since last update - follow it along the mesh surface from old path end
+        if (MoveCorridorEnd(pathStartIndex, endPoly, endPoint))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: corridor end moved, m_polyLength=%u\n", m_polyLength);
+        }
+        else
+        {
+            m_polyLength -= pathStartIndex;
 
-        // try to adjust the suffix of the path instead of recalculating entire length
-        // at given interval the target cannot get too far from its last location
-        // thus we have less poly to cover
-        // sub-path of optimal path is optimal
+            // try to adjust the suffix of the path instead of recalculating entire length
+            // at given interval the target cannot get too far from its last location
+            // thus we have less poly to cover
+            // sub-path of optimal path is optimal
 
-        // take ~80% of the original length
-        // TODO : play with the values here
-        uint32 prefixPolyLength = uint32(m_polyLength * 0.8f + 0.5f);
-        memmove(m_pathPolyRefs, m_pathPolyRefs + pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
+            // take ~80% of the original length
+            // TODO : play with the values here
+            uint32 prefixPolyLength = uint32(m_polyLength * 0.8f + 0.5f);
+            memmove(m_pathPolyRefs, m_pathPolyRefs + pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
 
-        dtPolyRef suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+            dtPolyRef suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
 
-        // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
-        float suffixEndPoint[VERTEX_SIZE];
-        if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
-        {
-            // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
-            // try to recover by using prev polyref
-            --prefixPolyLength;
-            suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+            // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
+            float suffixEndPoint[VERTEX_SIZE];
             if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
             {
-                // suffixStartPoly is still invalid, error state
-                BuildShortcut();
-                m_type = PATHFIND_NOPATH;
-                return;
+                // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
+                // try to recover by using prev polyref
+                --prefixPolyLength;
+                suffixStartPoly = m_pathPolyRefs[prefixPolyLength - 1];
+                if (dtStatusFailed(m_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
+                {
+                    // suffixStartPoly is still invalid, error state
+                    BuildShortcut();
+                    m_type = PATHFIND_NOPATH;
+                    return;
+                }
             }
-        }
-
-        // generate suffix
-        uint32 suffixPolyLength = 0;
-        dtResult = m_navMeshQuery->findPath(
-                       suffixStartPoly,    // start polygon
-                       endPoly,            // end polygon
-                       suffixEndPoint,     // start position
-                       endPoint,           // end position
-                       &m_filter,            // polygon search filter
-                       m_pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                       (int*)&suffixPolyLength,
-                       MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
 
-        if (!suffixPolyLength || dtStatusFailed(dtResult))
-        {
-            // this is probably an error state, but we'll leave it
-            // and hopefully recover on the next Update
-            // we still need to copy our preffix
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-        }
+            // generate suffix
+            uint32 suffixPolyLength = 0;
+            dtResult = m_navMeshQuery->findPath(
+                           suffixStartPoly,    // start polygon
+                           endPoly,            // end polygon
+                           suffixEndPoint,     // start position
+                           endPoint,           // end position
+                           &m_filter,            // polygon search filter
+                           m_pathPolyRefs + prefixPolyLength - 1,    // [out] path
+                           (int*)&suffixPolyLength,
+                           MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
+
+            if (!suffixPolyLength || dtStatusFailed(dtResult))
+            {
+                // this is probably an error state, but we'll leave it
+                // and hopefully recover on the next Update
+                // we still need to copy our preffix
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceGuidLow);
+            }
 
-        DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", m_polyLength, prefixPolyLength, suffixPolyLength);
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", m_polyLength, prefixPolyLength, suffixPolyLength);
 
-        // new path = prefix + suffix - overlap
-        m_polyLength = prefixPolyLength + suffixPolyLength - 1;
+            // new path = prefix + suffix - overlap
+            m_polyLength = prefixPolyLength + suffixPolyLength - 1;
+        }
     }
     else
     {
@@ -373,23 +501,34 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // pets and followers repeat same searches often, reuse recent result if any
+        if (m_pathCache && m_pathCache->Find(startPoly, endPoly, m_filter, m_pathPolyRefs, m_polyLength))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: cached path, m_polyLength=%u\n", m_polyLength);
+        }
+        else
+        {
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceGuidLow);
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            if (m_pathCache)
+                m_pathCache->Add(startPoly, endPoly, m_filter, m_pathPolyRefs, m_polyLength);
         }
     }
 
@@ -399,10 +538,39 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
     else
         m_type = PATHFIND_INCOMPLETE;
 
+    // end point is on last poly, path end can follow the target from there in next calculation
+    m_corridorEndValid = m_pathPolyRefs[m_polyLength - 1] == endPoly;
+    m_corridorEndPosition = Vector3(endPoint[2], endPoint[0], endPoint[1]);
+
     // generate the point-path out of our up-to-date poly-path
     BuildPointPath(startPoint, endPoint);
 }
 
+bool PathFinder::MoveCorridorEnd(uint32 pathStartIndex, dtPolyRef endPoly, const float* endPoint)
+{
+    if (!m_corridorEndValid)
+        return false;
+
+    // same as dtPathCorridor::moveTarget(), only a short move is expected
+    static const uint32 MAX_CORRIDOR_VISIT = 16;
+    dtPolyRef visited[MAX_CORRIDOR_VISIT];
+    int nvisited = 0;
+    float corridorEnd[VERTEX_SIZE] = {m_corridorEndPosition.y, m_corridorEndPosition.z, m_corridorEndPosition.x};
+    float resultPos[VERTEX_SIZE];
+
+    dtStatus dtResult = m_navMeshQuery->moveAlongSurface(m_pathPolyRefs[m_polyLength - 1], corridorEnd, endPoint, &m_filter,
+                        resultPos, visited, &nvisited, MAX_CORRIDOR_VISIT);
+
+    // target moved too far or behind some obstacle, needs path search
+    if (dtStatusFailed(dtResult) || !nvisited || visited[nvisited - 1] != endPoly)
+        return false;
+
+    m_polyLength -= pathStartIndex;
+    memmove(m_pathPolyRefs, m_pathPolyRefs + pathStartIndex, m_polyLength * sizeof(dtPolyRef));
+    m_polyLength = fixupCorridorEnd(m_pathPolyRefs, m_polyLength, MAX_PATH_LENGTH, visited, nvisited);
+    return true;
+}
+
 void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
@@ -536,8 +704,6 @@ void PathFinder::BuildPointPath(const float* startPoint, const float* endPoint)
         m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
     }
 
-    NormalizePath();
-
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::BuildPointPath path type %d size %d poly-size %d\n", m_type, pointCount, m_polyLength);
 }
 
@@ -563,8 +729,6 @@ void PathFinder::BuildShortcut()
     m_pathPoints[0] = getStartPosition();
     m_pathPoints[1] = getActualEndPosition();
 
-    NormalizePath();
-
     m_type = PATHFIND_SHORTCUT;
 }
 
@@ -691,6 +855,42 @@ uint32 PathFinder::fixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath,
     return req + size;
 }
 
+uint32 PathFinder::fixupCorridorEnd(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
+{
+    int32 furthestPath = -1;
+    int32 furthestVisited = -1;
+
+    // Find furthest common polygon.
+    for (uint32 i = 0; i < npath; ++i)
+    {
+        bool found = false;
+        for (int32 j = nvisited - 1; j >= 0; --j)
+        {
+            if (path[i] == visited[j])
+            {
+                furthestPath = i;
+                furthestVisited = j;
+                found = true;
+            }
+        }
+        if (found)
+            break;
+    }
+
+    // If no intersection found just return current path.
+    if (furthestPath == -1 || furthestVisited == -1)
+        return npath;
+
+    // Concatenate paths.
+    uint32 ppos = furthestPath + 1;
+    uint32 vpos = furthestVisited + 1;
+    uint32 count = std::min(nvisited - vpos, maxPath - ppos);
+    if (count)
+        memcpy(path + ppos, visited + vpos, count * sizeof(dtPolyRef));
+
+    return ppos + count;
+}
+
 bool PathFinder::getSteerTarget(const float* startPos, const float* endPos,
                                 float minTargetDist, const dtPolyRef* path, uint32 pathSize,
                                 float* steerPos, unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const
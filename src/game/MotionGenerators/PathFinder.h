@@ -26,11 +26,19 @@
 
 #include "Movement/MoveSplineInitArgs.h"
 
+#include <atomic>
+#include <memory>
+
 using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
 
+namespace MMAP
+{
+    class NavMeshPathCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -58,7 +66,14 @@ enum PathType
     PATHFIND_SHORT          = 0x0020,   // path is longer or equal to its limited path length
 };
 
-class PathFinder
+enum PathRequestState
+{
+    PATH_REQUEST_NONE       = 0,    // no queued calculation
+    PATH_REQUEST_QUEUED     = 1,    // waiting for or in calculation by path finder worker
+    PATH_REQUEST_DONE       = 2,    // calculated by path finder worker, result not picked up yet
+};
+
+class PathFinder : public std::enable_shared_from_this<PathFinder>
 {
     public:
         PathFinder(Unit const* owner);
@@ -68,6 +83,21 @@ class PathFinder
         // return: true if new path was calculated, false otherwise (no change needed)
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
 
+        // Queue path calculation to path finder workers, only for PathFinder owned by std::shared_ptr
+        // return: true if result is available at once (no workers or navmesh not used), otherwise use popResult() in later updates
+        bool calculateAsync(float destX, float destY, float destZ, bool forceDest = false);
+
+        // queued path is owned by path finder worker until picked up, no other calls allowed meanwhile
+        bool isQueued() const { return m_requestState != PATH_REQUEST_NONE; }
+
+        // Pick up path calculated by path finder worker, must be called in owner map update
+        // return: true if result is ready, false while still calculating
+        bool popResult();
+
+        // called by path finder worker, query is nullptr if the navmesh was unloaded meanwhile
+        void calculateQueued(dtNavMeshQuery const* query);
+        uint32 getMapId() const { return m_sourceMapId; }
+
         // option setters - use optional
         void setUseStrightPath(bool useStraightPath) { m_useStraightPath = useStraightPath; };
         void setPathLengthLimit(float distance) { m_pointPathLimit = std::min<uint32>(uint32(distance / SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); };
@@ -95,10 +125,26 @@ class PathFinder
         Vector3        m_startPosition;    // {x, y, z} of current location
         Vector3        m_endPosition;      // {x, y, z} of the destination
         Vector3        m_actualEndPosition;// {x, y, z} of the closest possible point to given destination
-
-        const Unit* const       m_sourceUnit;       // the unit that is moving
+        Vector3        m_corridorEndPosition;// {x, y, z} on last poly of m_pathPolyRefs, valid only when m_corridorEndValid
+        bool           m_corridorEndValid;
+
+        const Unit* const       m_sourceUnit;       // the unit that is moving, not accessed by path finder workers
+        uint32                  m_sourceGuidLow;
+        uint32                  m_sourceMapId;
+        uint8                   m_sourceTypeId;
+        bool                    m_sourceCanFly;     // owner movement abilities at calculation start
+        bool                    m_sourceCanSwim;
+
+        bool m_terrainCached;                       // liquid state below is captured for path finder worker
+        bool m_startSwimmable;
+        bool m_endSwimmable;
+        bool m_startUnderWater;
+        bool m_endUnderWater;
+
+        std::atomic<uint8> m_requestState;          // PathRequestState
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        MMAP::NavMeshPathCache* m_pathCache;        // recent poly paths of the nav mesh
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -107,9 +153,15 @@ class PathFinder
         void setActualEndPosition(const Vector3& point) { m_actualEndPosition = point; }
         void NormalizePath();
 
+        bool preparePath(float destX, float destY, float destZ, bool forceDest, bool& usePolyPath);
+        void cacheTerrainInfo();
+        bool isSwimmable(const Vector3& p, bool isStart) const;
+        bool isUnderWater(const Vector3& p, bool isStart) const;
+
         void clear()
         {
             m_polyLength = 0;
+            m_corridorEndValid = false;
             m_pathPoints.clear();
         }
 
@@ -122,6 +174,7 @@ class PathFinder
         bool HaveTile(const Vector3& p) const;
 
         void BuildPolyPath(const Vector3& startPos, const Vector3& endPos);
+        bool MoveCorridorEnd(uint32 pathStartIndex, dtPolyRef endPoly, const float* endPoint);
         void BuildPointPath(const float* startPoint, const float* endPoint);
         void BuildShortcut();
 
@@ -132,6 +185,8 @@ class PathFinder
         // smooth path aux functions
         uint32 fixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath,
                              const dtPolyRef* visited, uint32 nvisited);
+        uint32 fixupCorridorEnd(dtPolyRef* path, uint32 npath, uint32 maxPath,
+                                const dtPolyRef* visited, uint32 nvisited);
         bool getSteerTarget(const float* startPos, const float* endPos, float minTargetDist,
                             const dtPolyRef* path, uint32 pathSize, float* steerPos,
                             unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const;
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PathFinderQueue.h"
+#include "PathFinder.h"
+#include "MoveMap.h"
+#include "Log.h"
+
+INSTANTIATE_SINGLETON_1(PathFinderQueue);
+
+PathFinderQueue::PathFinderQueue() : m_stopping(false)
+{
+}
+
+PathFinderQueue::~PathFinderQueue()
+{
+    Stop();
+}
+
+void PathFinderQueue::Start(uint32 workerCount)
+{
+    if (IsRunning() || !workerCount)
+        return;
+
+    m_stopping = false;
+    for (uint32 i = 0; i < workerCount; ++i)
+        m_workers.push_back(std::thread(&PathFinderQueue::WorkerThread, this, i));
+
+    sLog.outString("PathFinder: started %u worker thread(s)", workerCount);
+}
+
+void PathFinderQueue::Stop()
+{
+    if (!IsRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_stopping = true;
+    }
+    m_queueCondition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    // owners still wait for these, complete them with shortcut paths
+    for (auto& path : m_queue)
+        path->calculateQueued(nullptr);
+    m_queue.clear();
+}
+
+bool PathFinderQueue::Enqueue(std::shared_ptr<PathFinder> const& path)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        if (m_workers.empty() || m_stopping)
+            return false;
+
+        m_queue.push_back(path);
+    }
+    m_queueCondition.notify_one();
+    return true;
+}
+
+void PathFinderQueue::WorkerThread(uint32 workerId)
+{
+    for (;;)
+    {
+        std::shared_ptr<PathFinder> path;
+        {
+            std::unique_lock<std::mutex> guard(m_queueLock);
+            m_queueCondition.wait(guard, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping)
+                return;
+
+            path = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        // path already dropped by its owner, nobody waits for result
+        if (path.unique())
+            continue;
+
+        std::unique_lock<std::mutex> tileGuard;
+        dtNavMeshQuery const* query = MMAP::MMapFactory::createOrGetMMapManager()->GetWorkerNavMeshQuery(path->getMapId(), workerId, tileGuard);
+        path->calculateQueued(query);
+    }
+}
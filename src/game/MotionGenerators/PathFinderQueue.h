@@ -0,0 +1,68 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATH_FINDER_QUEUE_H
+#define MANGOS_PATH_FINDER_QUEUE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PathFinder;
+
+/**
+ * Runs navmesh part of PathFinder calculations outside of map update.
+ *
+ * Paths are queued by PathFinder::calculateAsync() and picked up by owner with PathFinder::popResult().
+ * Every worker thread uses own dtNavMeshQuery, navmesh tiles are locked while calculation is running.
+ */
+class PathFinderQueue
+{
+    public:
+        PathFinderQueue();
+        ~PathFinderQueue();
+
+        void Start(uint32 workerCount);
+        void Stop();
+
+        bool IsRunning() const { return !m_workers.empty(); }
+
+        // return: false if no workers running, path must be calculated by caller then
+        bool Enqueue(std::shared_ptr<PathFinder> const& path);
+
+    private:
+        void WorkerThread(uint32 workerId);
+
+        typedef std::deque<std::shared_ptr<PathFinder> > PathQueue;
+
+        std::vector<std::thread> m_workers;
+        PathQueue m_queue;
+        std::mutex m_queueLock;
+        std::condition_variable m_queueCondition;
+        bool m_stopping;
+};
+
+#define sPathFinderQueue MaNGOS::Singleton<PathFinderQueue>::Instance()
+
+#endif
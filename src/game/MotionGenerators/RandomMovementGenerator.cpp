@@ -22,6 +22,7 @@
 #include "Util.h"
 #include "Movement/MoveSplineInit.h"
 #include "Movement/MoveSpline.h"
+#include "PathFinder.h"
 
 template<>
 RandomMovementGenerator<Creature>::RandomMovementGenerator(const Creature& creature): i_verticalZ(0)
@@ -35,6 +36,19 @@ RandomMovementGenerator<Creature>::RandomMovementGenerator(const Creature& creat
     i_radius = wander_distance;
 }
 
+template<>
+void RandomMovementGenerator<Creature>::_launchPath(Creature& creature)
+{
+    Movement::MoveSplineInit init(creature);
+    init.MovebyPath(i_path->getPath());
+    init.SetWalk(true);
+    init.Launch();
+    if (roll_chance_i(MOVEMENT_RANDOM_MMGEN_CHANCE_NO_BREAK))
+        i_nextMoveTime.Reset(50);
+    else
+        i_nextMoveTime.Reset(urand(3000, 10000));           // Keep a short wait time
+}
+
 template<>
 void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
 {
@@ -47,14 +61,13 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
     // check if new random position is assigned (GetReachableRandomPosition may fail) and dest is visible
     if (creature.GetMap()->GetReachableRandomPosition(&creature, destX, destY, destZ, i_radius) && creature.IsWithinLOS(destX, destY, destZ))
     {
-        Movement::MoveSplineInit init(creature);
-        init.MoveTo(destX, destY, destZ, true);
-        init.SetWalk(true);
-        init.Launch();
-        if (roll_chance_i(MOVEMENT_RANDOM_MMGEN_CHANCE_NO_BREAK))
-            i_nextMoveTime.Reset(50);
-        else
-            i_nextMoveTime.Reset(urand(3000, 10000));       // Keep a short wait time
+        i_path = std::make_shared<PathFinder>(&creature);
+
+        // creature stays idle until path finder worker result is picked up
+        if (!i_path->calculateAsync(destX, destY, destZ))
+            return;
+
+        _launchPath(creature);
     }
     else
         i_nextMoveTime.Reset(50);                           // Retry later
@@ -64,6 +77,7 @@ template<>
 void RandomMovementGenerator<Creature>::Initialize(Creature& creature)
 {
     creature.addUnitState(UNIT_STAT_ROAMING);               // _MOVE set in _setRandomLocation
+    i_path.reset();                                         // path queued before interrupt started from old position
 
     if (!creature.isAlive() || creature.hasUnitState(UNIT_STAT_NOT_MOVE))
         return;
@@ -99,6 +113,14 @@ bool RandomMovementGenerator<Creature>::Update(Creature& creature, const uint32&
     {
         i_nextMoveTime.Reset(0);  // Expire the timer
         creature.clearUnitState(UNIT_STAT_ROAMING_MOVE);
+        i_path.reset();
+        return true;
+    }
+
+    if (i_path && i_path->isQueued())
+    {
+        if (i_path->popResult())
+            _launchPath(creature);
         return true;
     }
 
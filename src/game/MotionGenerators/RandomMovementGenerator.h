@@ -21,6 +21,10 @@
 
 #include "MovementGenerator.h"
 
+#include <memory>
+
+class PathFinder;
+
 // define chance for creature to not stop after reaching a waypoint
 #define MOVEMENT_RANDOM_MMGEN_CHANCE_NO_BREAK 30
 
@@ -41,10 +45,13 @@ class RandomMovementGenerator
         bool Update(T&, const uint32&);
         MovementGeneratorType GetMovementGeneratorType() const override { return RANDOM_MOTION_TYPE; }
     private:
+        void _launchPath(T&);
+
         ShortTimeTracker i_nextMoveTime;
         float i_x, i_y, i_z;
         float i_radius;
         float i_verticalZ;
+        std::shared_ptr<PathFinder> i_path;                 // shared with path finder worker while queued
 };
 
 #endif
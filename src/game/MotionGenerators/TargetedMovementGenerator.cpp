@@ -46,7 +46,7 @@ const char* ChaseModes[] =
 
 //-----------------------------------------------//
 template<class T, typename D>
-void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool updateDestination)
+void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool updateDestination, bool async)
 {
     if (!i_target.isValid() || !i_target->IsInWorld())
         return;
@@ -94,13 +94,28 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool up
         z = end.z;
     }
 
-    if (!i_path)
-        i_path = new PathFinder(&owner);
+    // queued calculation is left to path finder worker, its result is not needed anymore
+    if (!i_path || i_path->isQueued())
+        i_path = std::make_shared<PathFinder>(&owner);
 
     // allow pets following their master to cheat while generating paths
     bool forceDest = (owner.GetTypeId() == TYPEID_UNIT && ((Creature*)&owner)->IsPet()
                       && owner.hasUnitState(UNIT_STAT_FOLLOW));
-    i_path->calculate(x, y, z, forceDest);
+    if (async)
+    {
+        // spline is launched when path finder worker result is picked up
+        if (!i_path->calculateAsync(x, y, z, forceDest))
+            return;
+    }
+    else
+        i_path->calculate(x, y, z, forceDest);
+
+    _launchPath(owner);
+}
+
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_launchPath(T& owner)
+{
     if (i_path->getPathType() & PATHFIND_NOPATH)
         return;
 
@@ -187,7 +202,7 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
 template<class T, typename D>
 bool TargetedMovementGeneratorMedium<T, D>::IsReachable() const
 {
-    return (i_path) ? (i_path->getPathType() & PATHFIND_NORMAL) : true;
+    return (i_path && !i_path->isQueued()) ? (i_path->getPathType() & PATHFIND_NORMAL) : true;
 }
 
 template<class T, typename D>
@@ -280,6 +295,15 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
         }
         else m_closenessAndFanningTimer -= time_diff;
     }
+
+    // keep current spline until path finder worker result is ready
+    if (this->i_path && this->i_path->isQueued())
+    {
+        if (this->i_path->popResult())
+            DispatchChasePath(owner);
+        return;
+    }
+
     if (!this->i_recheckDistance.Passed())
         return;
 
@@ -317,19 +341,12 @@ void ChaseMovementGenerator::HandleTargetedMovement(Unit& owner, const uint32& t
                 z = end.z;
             }
 
-            if (DispatchSplineToPosition(owner, x, y, z, EnableWalking(), true))
-            {
-                this->i_targetReached = false;
-                this->m_speedChanged = false;
-                /* m_prevTargetPos is updated on making new spline (normal and distancing) and also on reaching target
-                is used for determining if player moved towards target whilst the spline was going on to stop the spline prematurely
-                and prevent it going behind targets back - it will still occur in rare cases due to PF and lag */
-                this->i_target->GetPosition(this->m_prevTargetPos.x, this->m_prevTargetPos.y, this->m_prevTargetPos.z);
-                m_closenessAndFanningTimer = 0;
-                return;
-            }
-            // if we arrived here something failed in PF dispatch and target is not reachable
-            m_reachable = false;
+            if (!this->i_path)
+                this->i_path = std::make_shared<PathFinder>(&owner);
+
+            // spline is launched when path finder worker result is picked up
+            if (this->i_path->calculateAsync(x, y, z, false))
+                DispatchChasePath(owner);
             return;
         }
         else if (!targetMoved) // we do not need new position and we are reachable
@@ -499,12 +516,35 @@ void ChaseMovementGenerator::FanOut(Unit& owner)
     }
 }
 
+void ChaseMovementGenerator::DispatchChasePath(Unit& owner)
+{
+    if (DispatchPath(owner, EnableWalking(), true))
+    {
+        this->i_targetReached = false;
+        this->m_speedChanged = false;
+        /* m_prevTargetPos is updated on making new spline (normal and distancing) and also on reaching target
+        is used for determining if player moved towards target whilst the spline was going on to stop the spline prematurely
+        and prevent it going behind targets back - it will still occur in rare cases due to PF and lag */
+        this->i_target->GetPosition(this->m_prevTargetPos.x, this->m_prevTargetPos.y, this->m_prevTargetPos.z);
+        m_closenessAndFanningTimer = 0;
+        return;
+    }
+    // if we arrived here something failed in PF dispatch and target is not reachable
+    m_reachable = false;
+}
+
 bool ChaseMovementGenerator::DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath)
 {
-    if (!this->i_path)
-        this->i_path = new PathFinder(&owner);
+    // queued calculation is left to path finder worker, its result is not needed anymore
+    if (!this->i_path || this->i_path->isQueued())
+        this->i_path = std::make_shared<PathFinder>(&owner);
 
     this->i_path->calculate(x, y, z, false);
+    return DispatchPath(owner, walk, cutPath);
+}
+
+bool ChaseMovementGenerator::DispatchPath(Unit& owner, bool walk, bool cutPath)
+{
     if (this->i_path->getPathType() & PATHFIND_NOPATH)
         return false;
 
@@ -676,6 +716,14 @@ float FollowMovementGenerator<T>::GetDynamicTargetDistance(T& owner, bool forRan
 template<class T>
 void FollowMovementGenerator<T>::HandleTargetedMovement(T& owner, const uint32& time_diff)
 {
+    // keep current spline until path finder worker result is ready
+    if (this->i_path && this->i_path->isQueued())
+    {
+        if (this->i_path->popResult())
+            this->_launchPath(owner);
+        return;
+    }
+
     bool targetMoved = false;
     this->i_recheckDistance.Update(time_diff);
     if (this->i_recheckDistance.Passed())
@@ -713,7 +761,7 @@ void FollowMovementGenerator<T>::HandleTargetedMovement(T& owner, const uint32&
     }
 
     if (this->m_speedChanged || targetMoved)
-        this->_setTargetLocation(owner, targetMoved);
+        this->_setTargetLocation(owner, targetMoved, true);
 }
 
 template<class T>
@@ -732,9 +780,11 @@ void FollowMovementGenerator<T>::HandleFinalizedMovement(T& owner)
 }
 
 //-----------------------------------------------//
-template void TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator>::_setTargetLocation(Unit&, bool);
-template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_setTargetLocation(Player&, bool);
-template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_setTargetLocation(Creature&, bool);
+template void TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator>::_setTargetLocation(Unit&, bool, bool);
+template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_setTargetLocation(Player&, bool, bool);
+template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_setTargetLocation(Creature&, bool, bool);
+template void TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::_launchPath(Player&);
+template void TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::_launchPath(Creature&);
 template bool TargetedMovementGeneratorMedium<Unit, ChaseMovementGenerator>::Update(Unit&, const uint32&);
 template bool TargetedMovementGeneratorMedium<Player, FollowMovementGenerator<Player> >::Update(Player&, const uint32&);
 template bool TargetedMovementGeneratorMedium<Creature, FollowMovementGenerator<Creature> >::Update(Creature&, const uint32&);
@@ -24,6 +24,8 @@
 #include "MotionGenerators/FollowerReference.h"
 #include <G3D/Vector3.h>
 
+#include <memory>
+
 class PathFinder;
 
 class TargetedMovementGeneratorBase
@@ -49,7 +51,7 @@ class TargetedMovementGeneratorMedium
             i_path(nullptr), i_faceTarget(true)
         {
         }
-        ~TargetedMovementGeneratorMedium() { delete i_path; }
+        ~TargetedMovementGeneratorMedium() {}
 
     public:
         bool Update(T&, const uint32&);
@@ -63,7 +65,8 @@ class TargetedMovementGeneratorMedium
         virtual void UnitSpeedChanged() override { m_speedChanged = true; }
 
     protected:
-        void _setTargetLocation(T&, bool updateDestination);
+        void _setTargetLocation(T&, bool updateDestination, bool async = false);
+        void _launchPath(T&);
         virtual bool RequiresNewPosition(T& owner, float x, float y, float z) const;
         virtual float GetDynamicTargetDistance(T& /*owner*/, bool /*forRangeCheck*/) const { return i_offset; }
         virtual bool ShouldFaceTarget() const { return i_faceTarget; }
@@ -79,7 +82,7 @@ class TargetedMovementGeneratorMedium
         bool i_targetReached : 1;
         bool i_faceTarget : 1;
 
-        PathFinder* i_path;
+        std::shared_ptr<PathFinder> i_path;                 // shared with path finder worker while queued
 };
 
 /*
@@ -138,6 +141,8 @@ class ChaseMovementGenerator : public TargetedMovementGeneratorMedium<Unit, Chas
 
     private:
         bool DispatchSplineToPosition(Unit& owner, float x, float y, float z, bool walk, bool cutPath);
+        bool DispatchPath(Unit& owner, bool walk, bool cutPath);
+        void DispatchChasePath(Unit& owner);
         void CutPath(Unit& owner, PointsArray& path);
         void Backpedal(Unit& owner);
 
@@ -355,7 +355,6 @@ void FlightPathMovementGenerator::Reset(Player& player)
     Initialize(player);
 }
 
-#define PLAYER_FLIGHT_SPEED        32.0f
 
 bool FlightPathMovementGenerator::Update(Player& player, const uint32& /*diff*/)
 {
@@ -32,6 +32,7 @@
 #include <set>
 
 #define FLIGHT_TRAVEL_UPDATE  100
+#define PLAYER_FLIGHT_SPEED   32.0f
 #define STOP_TIME_FOR_PLAYER  (3 * MINUTE * IN_MILLISECONDS)// 3 Minutes
 
 template<class T, class P>
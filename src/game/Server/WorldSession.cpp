@@ -613,6 +613,9 @@ void WorldSession::LogoutPlayer(bool save)
         stmt = CharacterDatabase.CreateStatement(updChars, "UPDATE characters SET online = 0 WHERE account = ?");
         stmt.PExecute(GetAccountId());
 
+        ///- Character list shows data of the logout save
+        sWorld.InvalidateCharEnum(GetAccountId());
+
         DEBUG_LOG("SESSION: Sent SMSG_LOGOUT_COMPLETE Message");
     }
 
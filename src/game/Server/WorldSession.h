@@ -308,7 +308,7 @@ class WorldSession
         void HandleCharDeleteOpcode(WorldPacket& recvPacket);
         void HandleCharCreateOpcode(WorldPacket& recvPacket);
         void HandlePlayerLoginOpcode(WorldPacket& recvPacket);
-        void HandleCharEnum(QueryResult* result);
+        void HandleCharEnum(QueryResult* result, uint32 cacheGeneration);
         void HandlePlayerLogin(LoginQueryHolder* holder);
         void HandlePlayerReconnect();
 
@@ -2255,6 +2255,13 @@ class SpellMgr
             return nullptr;
         }
 
+        // Proc flags of aura, spell_proc_event flags override spell ones
+        uint32 GetSpellProcFlags(SpellEntry const* spellProto) const
+        {
+            SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellProto->Id);
+            return spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->procFlags;
+        }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
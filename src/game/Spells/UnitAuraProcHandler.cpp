@@ -393,20 +393,29 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
     ProcExecutionData execData(argData, isVictim);
 
+    // No aura can proc on these flags
+    if (!(execData.procFlags & m_procAuraHolderFlags))
+        return;
+
     RemoveSpellList removedSpells;
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+    for (ProcAuraHolderMap::const_iterator itr = m_procAuraHolders.begin(); itr != m_procAuraHolders.end(); ++itr)
     {
+        if (!(execData.procFlags & itr->second.second))
+            continue;
+
+        SpellAuraHolder* holder = itr->second.first;
+
         // skip deleted auras (possible at recursive triggered call
-        if (itr->second->GetState() != SPELLAURAHOLDER_STATE_READY || itr->second->IsDeleted())
+        if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
         SpellProcEventEntry const* spellProcEvent = nullptr;
-        if (!IsTriggeredAtSpellProcEvent(execData, itr->second, spellProcEvent))
+        if (!IsTriggeredAtSpellProcEvent(execData, holder, spellProcEvent))
             continue;
 
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     // Nothing found
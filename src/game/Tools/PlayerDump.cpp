@@ -21,6 +21,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Globals/ObjectMgr.h"
 #include "Accounts/AccountMgr.h"
+#include "World/World.h"
 
 // Character Dump tables
 struct DumpTable
@@ -60,28 +61,6 @@ static DumpTable dumpTables[] =
 };
 
 // Low level functions
-static bool findtoknth(std::string& str, int n, std::string::size_type& s, std::string::size_type& e)
-{
-    int i; s = e = 0;
-    std::string::size_type size = str.size();
-    for (i = 1; s < size && i < n; ++s) if (str[s] == ' ') ++i;
-    if (i < n)
-        return false;
-
-    e = str.find(' ', s);
-
-    return e != std::string::npos;
-}
-
-std::string gettoknth(std::string& str, int n)
-{
-    std::string::size_type s = 0, e = 0;
-    if (!findtoknth(str, n, s, e))
-        return "";
-
-    return str.substr(s, e - s);
-}
-
 bool findnth(std::string& str, int n, std::string::size_type& s, std::string::size_type& e)
 {
     s = str.find("VALUES ('") + 9;
@@ -145,21 +124,6 @@ std::string getnth(std::string& str, int n)
     return str.substr(s, e - s);
 }
 
-bool changetoknth(std::string& str, int n, const char* with, bool insert = false, bool nonzero = false)
-{
-    std::string::size_type s = 0, e = 0;
-    if (!findtoknth(str, n, s, e))
-        return false;
-    if (nonzero && str.substr(s, e - s) == "0")
-        return true;                                        // not an error
-    if (!insert)
-        str.replace(s, e - s, with);
-    else
-        str.insert(s, with);
-
-    return true;
-}
-
 uint32 registerNewGuid(uint32 oldGuid, std::map<uint32, uint32>& guidMap, uint32 hiGuid)
 {
     std::map<uint32, uint32>::const_iterator itr = guidMap.find(oldGuid);
@@ -184,19 +148,6 @@ bool changeGuid(std::string& str, int n, std::map<uint32, uint32>& guidMap, uint
     return changenth(str, n, chritem, false, nonzero);
 }
 
-bool changetokGuid(std::string& str, int n, std::map<uint32, uint32>& guidMap, uint32 hiGuid, bool nonzero = false)
-{
-    char chritem[20];
-    uint32 oldGuid = atoi(gettoknth(str, n).c_str());
-    if (nonzero && oldGuid == 0)
-        return true;                                        // not an error
-
-    uint32 newGuid = registerNewGuid(oldGuid, guidMap, hiGuid);
-    snprintf(chritem, 20, "%u", newGuid);
-
-    return changetoknth(str, n, chritem, false, nonzero);
-}
-
 std::string CreateDumpString(char const* tableName, QueryResult* result)
 {
     if (!tableName || !result)
@@ -264,10 +215,10 @@ void StoreGUID(QueryResult* result, uint32 field, std::set<uint32>& guids)
 void StoreGUID(QueryResult* result, uint32 data, uint32 field, std::set<uint32>& guids)
 {
     Field* fields = result->Fetch();
-    std::string dataStr = fields[data].GetCppString();
-    uint32 guid = atoi(gettoknth(dataStr, field).c_str());
-    if (guid)
-        guids.insert(guid);
+    uint32 values[CONTAINER_END];
+    int32 count = Object::DecodeValues(fields[data].GetString(), values, CONTAINER_END);
+    if (count > int32(field) && values[field])
+        guids.insert(values[field]);
 }
 
 // Writing - High-level functions
@@ -574,15 +525,18 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
                     ROLLBACK(DUMP_FILE_BROKEN);             // item_instance.guid update
                 if (!changenth(line, 2, newguid))           // item_instance.owner_guid update
                     ROLLBACK(DUMP_FILE_BROKEN);
-                std::string vals = getnth(line, 3);         // item_instance.data get
-                if (!changetokGuid(vals, OBJECT_FIELD_GUID + 1, items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed()))
-                    ROLLBACK(DUMP_FILE_BROKEN);             // item_instance.data.OBJECT_FIELD_GUID update
-                if (!changetoknth(vals, ITEM_FIELD_OWNER + 1, newguid))
-                    ROLLBACK(DUMP_FILE_BROKEN);             // item_instance.data.ITEM_FIELD_OWNER update
-                if (!changetokGuid(vals, ITEM_FIELD_ITEM_TEXT_ID + 1, itemTexts, sObjectMgr.m_ItemTextIds.GetNextAfterMaxUsed(), true))
-                    ROLLBACK(DUMP_FILE_BROKEN);
-                if (!changenth(line, 3, vals.c_str()))      // item_instance.data update
+                std::string vals = getnth(line, 3);         // item_instance.data get, dumps may hold either values format
+                uint32 values[CONTAINER_END];
+                int32 count = Object::DecodeValues(vals.c_str(), values, CONTAINER_END);
+                if (count < ITEM_END)
                     ROLLBACK(DUMP_FILE_BROKEN);
+                                                            // item_instance.data.OBJECT_FIELD_GUID update
+                values[OBJECT_FIELD_GUID] = registerNewGuid(values[OBJECT_FIELD_GUID], items, sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed());
+                values[ITEM_FIELD_OWNER] = guid;            // item_instance.data.ITEM_FIELD_OWNER update
+                if (values[ITEM_FIELD_ITEM_TEXT_ID])
+                    values[ITEM_FIELD_ITEM_TEXT_ID] = registerNewGuid(values[ITEM_FIELD_ITEM_TEXT_ID], itemTexts, sObjectMgr.m_ItemTextIds.GetNextAfterMaxUsed());
+                if (!changenth(line, 3, Object::EncodeValues(values, uint16(count)).c_str()))
+                    ROLLBACK(DUMP_FILE_BROKEN);             // item_instance.data update
                 break;
             }
             case DTT_ITEM_GIFT:
@@ -687,6 +641,7 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
     }
 
     CharacterDatabase.CommitTransaction();
+    sWorld.InvalidateCharEnum(account);
 
     // FIXME: current code with post-updating guids not safe for future per-map threads
     sObjectMgr.m_ItemGuids.Set(sObjectMgr.m_ItemGuids.GetNextAfterMaxUsed() + items.size());
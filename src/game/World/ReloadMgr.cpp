@@ -0,0 +1,152 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/ReloadMgr.h"
+#include "World/World.h"
+#include "Chat/Chat.h"
+#include "WorldPacket.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+INSTANTIATE_SINGLETON_1(ReloadMgr);
+
+static thread_local bool s_isReloadThread = false;
+
+bool ReloadMgr::IsReloadThread()
+{
+    return s_isReloadThread;
+}
+
+ReloadMgr::~ReloadMgr()
+{
+    Stop();
+}
+
+void ReloadMgr::Stop()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    // not applied reloads are dropped, loaded data is freed by their destructors
+    delete m_current;
+    m_current = nullptr;
+    for (BackgroundReload* reload : m_queue)
+        delete reload;
+    m_queue.clear();
+
+    for (auto& destroy : m_retired)
+        destroy();
+    m_retired.clear();
+}
+
+bool ReloadMgr::IsLoading()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_current || !m_queue.empty();
+}
+
+void ReloadMgr::AddReload(BackgroundReload* reload)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_stopping)
+        {
+            delete reload;
+            return;
+        }
+
+        m_queue.push_back(reload);
+    }
+
+    if (!m_thread.joinable())
+        m_thread = std::thread(&ReloadMgr::ReloadThread, this);
+
+    m_condition.notify_one();
+}
+
+void ReloadMgr::Update()
+{
+    // retired in previous tick, all map updates since then use new data
+    if (!m_retired.empty())
+    {
+        std::vector<std::function<void()> > retired;
+        retired.swap(m_retired);
+        for (auto& destroy : retired)
+            destroy();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (!m_loaded)
+            return;
+    }
+
+    // reload thread waits until current reload is applied
+    uint32 startTime = WorldTimer::getMSTime();
+    m_current->Apply();
+    sLog.outString("Reload of `%s` applied in %u ms", m_current->GetTableName(), WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+
+    std::string message = std::string("DB table `") + m_current->GetTableName() + "` reloaded.";
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_SYSTEM, message.c_str());
+    sWorld.SendGlobalMessage(data);
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        delete m_current;
+        m_current = nullptr;
+        m_loaded = false;
+    }
+    m_condition.notify_one();
+}
+
+void ReloadMgr::ReloadThread()
+{
+    WorldDatabase.ThreadStart();                            // let thread do safe mySQL requests
+    s_isReloadThread = true;
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    for (;;)
+    {
+        m_condition.wait(guard, [this] { return m_stopping || (!m_current && !m_queue.empty()); });
+        if (m_stopping)
+            break;
+
+        m_current = m_queue.front();
+        m_queue.pop_front();
+        guard.unlock();
+
+        sLog.outString("Re-Loading `%s` in background...", m_current->GetTableName());
+        uint32 startTime = WorldTimer::getMSTime();
+        m_current->Load();
+        sLog.outString("Reload of `%s` loaded in %u ms", m_current->GetTableName(), WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+
+        guard.lock();
+        m_loaded = true;
+    }
+    guard.unlock();
+
+    WorldDatabase.ThreadEnd();                              // free mySQL thread resources
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_RELOAD_MGR_H
+#define MANGOS_RELOAD_MGR_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * One DB table reload executed by ReloadMgr.
+ *
+ * Load() runs in the reload thread and must only build new data next to the published one,
+ * Apply() runs in world thread between map updates and publishes it (pointer swap).
+ */
+class BackgroundReload
+{
+    public:
+        explicit BackgroundReload(char const* tableName) : m_tableName(tableName) {}
+        virtual ~BackgroundReload() {}
+
+        virtual void Load() = 0;
+        virtual void Apply() = 0;
+
+        char const* GetTableName() const { return m_tableName; }
+
+    private:
+        char const* m_tableName;
+};
+
+/**
+ * Reloads DB tables at runtime without stopping world update for the load time.
+ *
+ * Reloads are loaded one by one, next one is started only after the previous one is applied,
+ * so the reload thread never sees data replaced by a reload. Replaced data is retired and
+ * destroyed in the following world tick, after all map updates holding references to it finished.
+ */
+class ReloadMgr
+{
+    public:
+        ReloadMgr() : m_current(nullptr), m_loaded(false), m_stopping(false) {}
+        ~ReloadMgr();
+
+        void Stop();
+
+        // takes ownership, reload start and finish are announced to players
+        void AddReload(BackgroundReload* reload);
+
+        // destroy is called at world tick boundary when no one can use replaced data anymore
+        void Retire(std::function<void()> destroy) { m_retired.push_back(destroy); }
+
+        // world thread: destroy retired data, apply loaded reload
+        void Update();
+
+        // true in Load() of reloads
+        static bool IsReloadThread();
+
+        // data read by Load() must not be reloaded in world thread meantime
+        bool IsLoading();
+
+    private:
+        void ReloadThread();
+
+        std::thread m_thread;
+        std::mutex m_lock;
+        std::condition_variable m_condition;
+        std::deque<BackgroundReload*> m_queue;              // waiting for load
+        BackgroundReload* m_current;                        // loading or loaded and waiting for apply
+        bool m_loaded;
+        bool m_stopping;
+
+        std::vector<std::function<void()> > m_retired;      // world thread only
+};
+
+#define sReloadMgr MaNGOS::Singleton<ReloadMgr>::Instance()
+
+#endif
@@ -51,6 +51,8 @@
 #include "OutdoorPvP/OutdoorPvP.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "MotionGenerators/PathFinderQueue.h"
+#include "World/ReloadMgr.h"
 #include "GameEvents/GameEventMgr.h"
 #include "Pools/PoolManager.h"
 #include "Database/DatabaseImpl.h"
@@ -95,7 +97,7 @@ TimePoint World::m_currentTime = TimePoint();
 uint32 World::m_currentDiff = 0;
 
 /// World constructor
-World::World(): mail_timer(0), mail_timer_expires(0)
+World::World(): mail_timer(0), mail_timer_expires(0), m_charEnumGeneration(0)
 {
     m_playerLimit = 0;
     m_allowMovement = true;
@@ -147,8 +149,11 @@ void World::CleanupsBeforeStop()
 {
     KickAll();                                       // save and kick all players
     UpdateSessions(1);                               // real players unload required UpdateSessions call
+    sPathFinderQueue.Stop();                         // no more navmesh use outside map update
+    sReloadMgr.Stop();                               // no more DB table loads in background
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
+    sMapPersistentStateMgr.SaveRespawnTimesToDB();   // write respawn times still buffered (including saved at grid unload)
 }
 
 /// Find a session by its id
@@ -444,6 +449,8 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfigMinMax(CONFIG_UINT32_COMPRESSION_STRATEGY, "Compression.Strategy", 0, 0, 3);  // zlib Z_DEFAULT_STRATEGY..Z_RLE
+    setConfig(CONFIG_UINT32_COMPRESSION_THRESHOLD, "Compression.Threshold", 100);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -467,6 +474,8 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetGridCleanUpDelay(getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN));
 
+    setConfig(CONFIG_UINT32_GRID_PREFETCH_TIME, "GridPrefetchTime", 10);
+
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
@@ -568,6 +577,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
+    setConfigMin(CONFIG_UINT32_MASS_MAILER_BULK_SEND_PER_TICK, "MassMailer.BulkSendPerTick", 5000, 1);
 
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
@@ -601,6 +611,12 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_RESPAWN_SAVE_INTERVAL, "SaveRespawnTime.Interval", 10 * IN_MILLISECONDS);
+    if (reload)
+    {
+        m_timers[WUPDATE_RESPAWNS].SetInterval(getConfig(CONFIG_UINT32_RESPAWN_SAVE_INTERVAL));
+        m_timers[WUPDATE_RESPAWNS].Reset();
+    }
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     setConfig(CONFIG_BOOL_ALWAYS_MAX_SKILL_FOR_LEVEL, "AlwaysMaxSkillForLevel", false);
@@ -610,6 +626,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHATFLOOD_MUTE_TIME,     "ChatFlood.MuteTime", 10);
 
     setConfig(CONFIG_BOOL_EVENT_ANNOUNCE, "Event.Announce", false);
+    setConfig(CONFIG_UINT32_GAME_EVENT_SPAWN_PER_TICK, "Event.SpawnPerTick", 100);
 
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       7000);
@@ -632,6 +649,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHAT_STRICT_LINK_CHECKING_KICK,     "ChatStrictLinkChecking.Kick", 0);
 
     setConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,                     "Corpse.EmptyLootShow",                  true);
+    setConfig(CONFIG_BOOL_CORPSE_DELAYED_LOOT_GENERATION,             "Corpse.DelayedLootGeneration",          false);
     setConfig(CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT, "Corpse.AllowAllItemsShowInMasterLoot", false);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_NORMAL,                      "Corpse.Decay.NORMAL",                    300);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_RARE,                        "Corpse.Decay.RARE",                      900);
@@ -720,6 +738,16 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInBG = MAX_VISIBILITY_DISTANCE;
     }
 
+    ///- Creature update rate by distance to players, applied to maps created after load
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_INNER_CONTINENTS, "UpdateLod.InnerDistance.Continents", 50.0f);
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_OUTER_CONTINENTS, "UpdateLod.OuterDistance.Continents", 75.0f);
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_INNER_INSTANCES,  "UpdateLod.InnerDistance.Instances",  0.0f);
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_OUTER_INSTANCES,  "UpdateLod.OuterDistance.Instances",  0.0f);
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_INNER_BG,         "UpdateLod.InnerDistance.BGArenas",   0.0f);
+    setConfigPos(CONFIG_FLOAT_UPDATE_LOD_OUTER_BG,         "UpdateLod.OuterDistance.BGArenas",   0.0f);
+    setConfigMinMax(CONFIG_UINT32_UPDATE_LOD_INTERVAL_MIDDLE, "UpdateLod.Interval.Middle", 2, 1, 16);
+    setConfigMinMax(CONFIG_UINT32_UPDATE_LOD_INTERVAL_OUTER,  "UpdateLod.Interval.Outer",  4, 1, 16);
+
     ///- Load the CharDelete related config options
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_METHOD, "CharDelete.Method", 0, 0, 1);
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0, 0, getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL));
@@ -770,9 +798,14 @@ void World::LoadConfigSettings(bool reload)
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
+    setConfig(CONFIG_BOOL_MMAP_PREFETCH, "mmap.prefetchTiles", true);
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    if (configNoReload(reload, CONFIG_UINT32_PATH_FIND_THREADS, "PathFinder.Threads", 0))
+        setConfig(CONFIG_UINT32_PATH_FIND_THREADS, "PathFinder.Threads", 0);
+    if (configNoReload(reload, CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 128))
+        setConfig(CONFIG_UINT32_PATH_FIND_CACHE_SIZE, "PathFinder.CacheSize", 128);
 
     sLog.outString();
 }
@@ -1232,6 +1265,7 @@ void World::SetInitialWorldSettings()
 
     // Update groups with offline leader after delay in seconds
     m_timers[WUPDATE_GROUPS].SetInterval(IN_MILLISECONDS);
+    m_timers[WUPDATE_RESPAWNS].SetInterval(getConfig(CONFIG_UINT32_RESPAWN_SAVE_INTERVAL));
 
     // to set mailtimer to return mails every day between 4 and 5 am
     // mailtimer is increased when updating auctions
@@ -1254,6 +1288,9 @@ void World::SetInitialWorldSettings()
     sMapMgr.Initialize();
     sLog.outString();
 
+    ///- Start path finder workers
+    sPathFinderQueue.Start(getConfig(CONFIG_UINT32_PATH_FIND_THREADS));
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -1371,6 +1408,12 @@ void World::Update(uint32 diff)
     ///-Update mass mailer tasks if any
     sMassMailMgr.Update();
 
+    ///- Spawn and despawn queued game event objects
+    sGameEventMgr.UpdateSpawnQueue();
+
+    ///- Publish tables reloaded in background before maps are updated
+    sReloadMgr.Update();
+
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
@@ -1467,6 +1510,14 @@ void World::Update(uint32 diff)
     // update the instance reset times
     sMapPersistentStateMgr.Update();
 
+    ///- Write buffered creature/gameobject respawn times
+    if (m_timers[WUPDATE_RESPAWNS].Passed())
+    {
+        m_timers[WUPDATE_RESPAWNS].Reset();
+
+        sMapPersistentStateMgr.SaveRespawnTimesToDB();
+    }
+
     if (m_MaintenanceTimeChecker < diff)
     {
         if (GetDateToday() >= m_NextMaintenanceDate)
@@ -1871,6 +1922,10 @@ void World::UpdateSessions(uint32 /*diff*/)
         if (!pSession->Update(updater))
         {
             RemoveQueuedSession(pSession);
+            {
+                std::lock_guard<std::mutex> guard(m_charEnumCacheLock);
+                m_charEnumCache.erase(pSession->GetAccountId());
+            }
             itr = m_sessions.erase(itr);
             delete pSession;
         }
@@ -2201,3 +2256,31 @@ void World::InvalidatePlayerDataToAllClient(ObjectGuid guid) const
     data << guid;
     SendGlobalMessage(data);
 }
+
+bool World::GetCachedCharEnum(uint32 accountId, WorldPacket& data)
+{
+    std::lock_guard<std::mutex> guard(m_charEnumCacheLock);
+    auto itr = m_charEnumCache.find(accountId);
+    if (itr == m_charEnumCache.end())
+        return false;
+
+    data = *itr->second;
+    return true;
+}
+
+void World::CacheCharEnum(uint32 accountId, WorldPacket const& data, uint32 generation)
+{
+    std::lock_guard<std::mutex> guard(m_charEnumCacheLock);
+    // characters may have been changed while the query was executed
+    if (generation != m_charEnumGeneration)
+        return;
+
+    m_charEnumCache[accountId].reset(new WorldPacket(data));
+}
+
+void World::InvalidateCharEnum(uint32 accountId)
+{
+    std::lock_guard<std::mutex> guard(m_charEnumCacheLock);
+    m_charEnumCache.erase(accountId);
+    ++m_charEnumGeneration;
+}
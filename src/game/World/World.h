@@ -32,6 +32,8 @@
 #include <list>
 #include <deque>
 #include <mutex>
+#include <atomic>
+#include <memory>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -77,15 +79,19 @@ enum WorldTimers
     WUPDATE_DELETECHARS = 4,
     WUPDATE_AHBOT       = 5,
     WUPDATE_GROUPS      = 6,
-    WUPDATE_COUNT       = 7
+    WUPDATE_RESPAWNS    = 7,
+    WUPDATE_COUNT       = 8
 };
 
 /// Configuration elements
 enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
+    CONFIG_UINT32_COMPRESSION_STRATEGY,
+    CONFIG_UINT32_COMPRESSION_THRESHOLD,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
+    CONFIG_UINT32_GRID_PREFETCH_TIME,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
@@ -109,6 +115,9 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MIN_HONOR_KILLS,
     CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR,
     CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,
+    CONFIG_UINT32_RESPAWN_SAVE_INTERVAL,
+    CONFIG_UINT32_PATH_FIND_THREADS,
+    CONFIG_UINT32_PATH_FIND_CACHE_SIZE,
     CONFIG_UINT32_MAX_SPELL_CASTS_IN_CHAIN,
     CONFIG_UINT32_RABBIT_DAY,
     CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL,
@@ -127,6 +136,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GM_INVISIBLE_AURA,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_MASS_MAILER_BULK_SEND_PER_TICK,
+    CONFIG_UINT32_GAME_EVENT_SPAWN_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
@@ -175,6 +186,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_FOGOFWAR_STEALTH,
     CONFIG_UINT32_FOGOFWAR_HEALTH,
     CONFIG_UINT32_FOGOFWAR_STATS,
+    CONFIG_UINT32_UPDATE_LOD_INTERVAL_MIDDLE,
+    CONFIG_UINT32_UPDATE_LOD_INTERVAL_OUTER,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -260,6 +273,12 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_UPDATE_LOD_INNER_CONTINENTS,
+    CONFIG_FLOAT_UPDATE_LOD_OUTER_CONTINENTS,
+    CONFIG_FLOAT_UPDATE_LOD_INNER_INSTANCES,
+    CONFIG_FLOAT_UPDATE_LOD_OUTER_INSTANCES,
+    CONFIG_FLOAT_UPDATE_LOD_INNER_BG,
+    CONFIG_FLOAT_UPDATE_LOD_OUTER_BG,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -296,6 +315,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_CHAT_STRICT_LINK_CHECKING_KICK,
     CONFIG_BOOL_ADDON_CHANNEL,
     CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,
+    CONFIG_BOOL_CORPSE_DELAYED_LOOT_GENERATION,
     CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVP,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVE,
@@ -318,6 +338,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_PET_ATTACK_FROM_BEHIND,
     CONFIG_BOOL_MMAP_ENABLED,
+    CONFIG_BOOL_MMAP_PREFETCH,
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
@@ -568,6 +589,13 @@ class World
         **/
         void InvalidatePlayerDataToAllClient(ObjectGuid guid) const;
 
+        /// SMSG_CHAR_ENUM packets of accounts, must be dropped at any change of the shown character data
+        bool GetCachedCharEnum(uint32 accountId, WorldPacket& data);
+        void CacheCharEnum(uint32 accountId, WorldPacket const& data, uint32 generation);
+        void InvalidateCharEnum(uint32 accountId);
+        /// packet built from a query sent before another invalidation is not cached
+        uint32 GetCharEnumGeneration() const { return m_charEnumGeneration; }
+
         static uint32 GetCurrentMSTime() { return m_currentMSTime; }
         static TimePoint GetCurrentClockTime() { return m_currentTime; }
         static uint32 GetCurrentDiff() { return m_currentDiff; }
@@ -647,6 +675,11 @@ class World
         std::mutex m_sessionAddQueueLock;
         std::deque<WorldSession*> m_sessionAddQueue;
 
+        // character list packets, accessed from session and map threads
+        std::mutex m_charEnumCacheLock;
+        std::unordered_map<uint32, std::unique_ptr<WorldPacket>> m_charEnumCache;
+        std::atomic<uint32> m_charEnumGeneration;
+
         // used versions
         std::string m_DBVersion;
         std::string m_CreatureEventAIVersion;
@@ -285,6 +285,7 @@ void ChatHandler::HandleCharacterDeletedRestoreHelper(DeletedInfo const& delInfo
 
     CharacterDatabase.PExecute("UPDATE characters SET name='%s', account='%u', deleteDate=NULL, deleteInfos_Name=NULL, deleteInfos_Account=NULL WHERE deleteDate IS NOT NULL AND guid = %u",
                                delInfo.name.c_str(), delInfo.accountId, delInfo.lowguid);
+    sWorld.InvalidateCharEnum(delInfo.accountId);
 }
 
 /**
@@ -17,15 +17,191 @@
  */
 
 #include "MaNGOSsoap.h"
+#include "Util.h"
 
+#include <future>
 #include <string>
 
-SOAPThread::SOAPThread(const std::string& host, int port) : m_host(host), m_port(port), m_workerThread(&SOAPThread::Work, this) {}
+SOAPCredentialCache::SOAPCredentialCache(uint32 cacheTime) : m_cacheTime(cacheTime)
+{
+    for (int i = 0; i < 16; ++i)
+        m_salt.push_back(char(urand(0, 255)));
+}
+
+void SOAPCredentialCache::HashPassword(const char* password, uint8* digest) const
+{
+    Sha1Hash sha;
+    sha.UpdateData(m_salt);
+    sha.UpdateData(password);
+    sha.Finalize();
+    memcpy(digest, sha.GetDigest(), SHA_DIGEST_LENGTH);
+}
+
+int SOAPCredentialCache::Verify(const char* username, const char* password, uint32& accountId)
+{
+    uint8 passwordHash[SHA_DIGEST_LENGTH];
+    // taken before the check, account changes done meanwhile drop the cached login
+    uint32 credentialsVersion = sAccountMgr.GetCredentialsVersion();
+    if (m_cacheTime)
+    {
+        HashPassword(password, passwordHash);
+
+        std::unique_lock<std::mutex> guard(m_lock);
+        auto itr = m_credentials.find(username);
+        if (itr != m_credentials.end())
+        {
+            if (itr->second.expireTime > time(nullptr) && itr->second.credentialsVersion == credentialsVersion &&
+                    !memcmp(itr->second.passwordHash, passwordHash, SHA_DIGEST_LENGTH))
+            {
+                accountId = itr->second.accountId;
+                guard.unlock();
+
+                // gm level may also be changed outside of this server, it is cheap to check
+                if (sAccountMgr.GetSecurity(accountId) >= SOAPThread::MinLevel)
+                    return SOAP_OK;
+
+                DEBUG_LOG("MaNGOSsoap: %s's gmlevel is too low", username);
+                guard.lock();
+                m_credentials.erase(username);
+                return 403;
+            }
+
+            m_credentials.erase(itr);
+        }
+    }
+
+    accountId = sAccountMgr.GetId(username);
+    if (!accountId)
+    {
+        DEBUG_LOG("MaNGOSsoap: Client used invalid username '%s'", username);
+        return 401;
+    }
+
+    if (!sAccountMgr.CheckPassword(accountId, password))
+    {
+        DEBUG_LOG("MaNGOSsoap: invalid password for account '%s'", username);
+        return 401;
+    }
+
+    if (sAccountMgr.GetSecurity(accountId) < SOAPThread::MinLevel)
+    {
+        DEBUG_LOG("MaNGOSsoap: %s's gmlevel is too low", username);
+        return 403;
+    }
+
+    if (m_cacheTime)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        Credential& credential = m_credentials[username];
+        credential.accountId = accountId;
+        memcpy(credential.passwordHash, passwordHash, SHA_DIGEST_LENGTH);
+        credential.expireTime = time(nullptr) + m_cacheTime;
+        credential.credentialsVersion = credentialsVersion;
+    }
+
+    return SOAP_OK;
+}
+
+// plain HTTP mode, GET /command?c=<url encoded command> with basic authentication, answered with JSON
+static int HttpGetCommand(soap* soap)
+{
+    const char* query = strchr(soap->path, '?');
+    if (!query || strncmp(soap->path, "/command?", 9) != 0)
+        return 404;
+
+    std::string command;
+    for (const char* param = query + 1; *param;)
+    {
+        const char* end = strchr(param, '&');
+        if (!end)
+            end = param + strlen(param);
+
+        if (param[0] == 'c' && param[1] == '=')
+        {
+            for (const char* c = param + 2; c < end; ++c)
+            {
+                if (*c == '+')
+                    command.push_back(' ');
+                else if (*c == '%' && end - c > 2 && isxdigit(c[1]) && isxdigit(c[2]))
+                {
+                    char hex[3] = { c[1], c[2], 0 };
+                    command.push_back(char(strtoul(hex, nullptr, 16)));
+                    c += 2;
+                }
+                else
+                    command.push_back(*c);
+            }
+        }
+
+        param = *end ? end + 1 : end;
+    }
+
+    uint32 accountId;
+    int status = static_cast<SOAPThread*>(soap->user)->CheckLogin(soap, accountId);
+    if (status != SOAP_OK)
+        return status;
+
+    if (command.empty())
+        return 400;
+
+    DEBUG_LOG("MaNGOSsoap: got HTTP command '%s'", command.c_str());
+
+    std::string output;
+    bool success = SOAPThread::ExecuteCommand(accountId, command.c_str(), output);
+
+    std::string json = success ? "{\"success\":true,\"output\":\"" : "{\"success\":false,\"output\":\"";
+    for (unsigned char c : output)
+    {
+        switch (c)
+        {
+            case '"':  json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            case '\n': json += "\\n"; break;
+            case '\r': json += "\\r"; break;
+            case '\t': json += "\\t"; break;
+            default:
+                if (c < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    json += escaped;
+                }
+                else
+                    json.push_back(char(c));
+                break;
+        }
+    }
+    json += "\"}";
+
+    soap->http_content = "application/json; charset=utf-8";
+    if (soap_response(soap, SOAP_FILE) || soap_send(soap, json.c_str()) || soap_end_send(soap))
+        return soap_closesock(soap);
+
+    return SOAP_OK;
+}
+
+SOAPThread::SOAPThread(const std::string& host, int port, int workerThreads, uint32 credentialCacheTime)
+    : m_host(host), m_port(port), m_stopping(false), m_credentials(credentialCacheTime)
+{
+    for (int i = 0; i < std::max(workerThreads, 1); ++i)
+        m_poolThreads.emplace_back(&SOAPThread::ServeConnections, this);
+
+    m_workerThread = std::thread(&SOAPThread::Work, this);
+}
 
 SOAPThread::~SOAPThread()
 {
     sLog.outError("SOAP shutting down");
     m_workerThread.join();
+
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_stopping = true;
+    }
+    m_queueCondition.notify_all();
+
+    for (auto& thread : m_poolThreads)
+        thread.join();
 }
 
 void SOAPThread::Work()
@@ -39,6 +215,8 @@ void SOAPThread::Work()
     soap.accept_timeout = AcceptTimeout;
     soap.recv_timeout = DataTimeout;
     soap.send_timeout = DataTimeout;
+    soap.user = this;
+    soap.fget = &HttpGetCommand;
 
     if (soap_bind(&soap, m_host.c_str(), m_port, BackLogSize) < 0)
     {
@@ -58,21 +236,52 @@ void SOAPThread::Work()
 
         DEBUG_LOG("MaNGOSsoap: accepted connection from IP=%d.%d.%d.%d", (int)(soap.ip >> 24) & 0xFF, (int)(soap.ip >> 16) & 0xFF, (int)(soap.ip >> 8) & 0xFF, (int)soap.ip & 0xFF);
 
+        // request is read and served by pool thread, so slow clients and commands don't block accepting
         auto copy = soap_copy(&soap);
-        soap_serve(copy);
-        soap_destroy(copy);
+        if (!copy)
+        {
+            soap_closesock(&soap);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_queueLock);
+            m_queue.push_back(copy);
+        }
+        m_queueCondition.notify_one();
     }
 
     soap_end(&soap);
     soap_done(&soap);
 }
 
-/*
-Code used for generating stubs:
+void SOAPThread::ServeConnections()
+{
+    for (;;)
+    {
+        soap* connection;
+        {
+            std::unique_lock<std::mutex> guard(m_queueLock);
+            m_queueCondition.wait(guard, [this] { return m_stopping || !m_queue.empty(); });
 
-int ns1__executeCommand(char* command, char** result);
-*/
-int ns1__executeCommand(soap* soap, char* command, char** result)
+            if (m_queue.empty())
+                return;
+
+            connection = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        // connection is only closed if server stops before it is served
+        if (!World::IsStopped())
+            soap_serve(connection);
+
+        soap_destroy(connection);
+        soap_end(connection);
+        soap_free(connection);
+    }
+}
+
+int SOAPThread::CheckLogin(soap* soap, uint32& accountId)
 {
     // security check
     if (!soap->userid || !soap->passwd)
@@ -81,54 +290,68 @@ int ns1__executeCommand(soap* soap, char* command, char** result)
         return 401;
     }
 
-    auto const accountId = sAccountMgr.GetId(soap->userid);
-    if (!accountId)
+    return m_credentials.Verify(soap->userid, soap->passwd, accountId);
+}
+
+bool SOAPThread::ExecuteCommand(uint32 accountId, const char* command, std::string& output)
+{
+    // shared with world thread callbacks, so waiting can be given up at shutdown
+    struct CommandResult
     {
-        DEBUG_LOG("MaNGOSsoap: Client used invalid username '%s'", soap->userid);
-        return 401;
-    }
+        std::string output;
+        std::promise<bool> finished;
+    };
+    auto result = std::make_shared<CommandResult>();
+    result->output.reserve(CommandOutputBufferSize);
+    std::future<bool> finished = result->finished.get_future();
 
-    if (!sAccountMgr.CheckPassword(accountId, soap->passwd))
+    // commands are executed in the world thread. We have to wait for them to be completed
+    sWorld.QueueCliCommand(new CliCommandHolder(accountId, SEC_CONSOLE, command,
+                           [result](const char* output)
     {
-        DEBUG_LOG("MaNGOSsoap: invalid password for account '%s'", soap->userid);
-        return 401;
-    }
+        assert(output);
+        result->output += output;
+    },
+    [result](bool success)
+    {
+        result->finished.set_value(success);
+    }));
 
-    if (sAccountMgr.GetSecurity(accountId) < SOAPThread::MinLevel)
+    while (finished.wait_for(std::chrono::seconds(1)) != std::future_status::ready)
     {
-        DEBUG_LOG("MaNGOSsoap: %s's gmlevel is too low", soap->userid);
-        return 403;
+        if (World::IsStopped())
+        {
+            output = "Server is shutting down";
+            return false;
+        }
     }
 
-    if (!command || !*command)
-        return soap_sender_fault(soap, "Command mustn't be empty", "The supplied command was an empty string");
+    bool success = finished.get();
+    output = result->output;
+    return success;
+}
 
-    DEBUG_LOG("MaNGOSsoap: got command '%s'", command);
+/*
+Code used for generating stubs:
 
-    bool commandExecuted = false, commandSucceeded = false;
-    std::vector<char> buffer;
-    buffer.reserve(SOAPThread::CommandOutputBufferSize);
+int ns1__executeCommand(char* command, char** result);
+*/
+int ns1__executeCommand(soap* soap, char* command, char** result)
+{
+    uint32 accountId;
+    int status = static_cast<SOAPThread*>(soap->user)->CheckLogin(soap, accountId);
+    if (status != SOAP_OK)
+        return status;
 
-    // commands are executed in the world thread. We have to wait for them to be completed
-    sWorld.QueueCliCommand(new CliCommandHolder(accountId, SEC_CONSOLE, command,
-                           [&buffer](const char* output)
-    {
-        assert(output);
+    if (!command || !*command)
+        return soap_sender_fault(soap, "Command mustn't be empty", "The supplied command was an empty string");
 
-        for (auto p = output; *p; ++p)
-            buffer.push_back(*p);
-    },
-    [soap, &commandExecuted, &commandSucceeded](bool success)
-    {
-        commandExecuted = true;
-        commandSucceeded = success;
-    }));
+    DEBUG_LOG("MaNGOSsoap: got command '%s'", command);
 
-    while (!commandExecuted)
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::string output;
+    bool commandSucceeded = SOAPThread::ExecuteCommand(accountId, command, output);
 
-    buffer.push_back(0);
-    auto const printBuffer = soap_strdup(soap, &buffer[0]);
+    auto const printBuffer = soap_strdup(soap, output.c_str());
 
     if (!commandSucceeded)
     {
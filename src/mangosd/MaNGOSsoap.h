@@ -23,17 +23,48 @@
 #include "World/World.h"
 #include "Accounts/AccountMgr.h"
 #include "Log.h"
+#include "Auth/Sha1.h"
 
 #include "soapH.h"
 #include "soapStub.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
+
+// verified soap logins, password is kept only as salted hash
+class SOAPCredentialCache
+{
+    public:
+        explicit SOAPCredentialCache(uint32 cacheTime);
+
+        // returns HTTP status code, SOAP_OK on success
+        int Verify(const char* username, const char* password, uint32& accountId);
+
+    private:
+        struct Credential
+        {
+            uint32 accountId;
+            uint8 passwordHash[SHA_DIGEST_LENGTH];
+            time_t expireTime;
+            uint32 credentialsVersion;                      // AccountMgr credentials version at verification
+        };
+
+        void HashPassword(const char* password, uint8* digest) const;
+
+        const uint32 m_cacheTime;                           // seconds, 0 disables cache
+        std::string m_salt;
+        std::unordered_map<std::string, Credential> m_credentials;
+        std::mutex m_lock;
+};
 
 class SOAPThread
 {
     private:
-        static const int WorkerThreads = 5;
         static const int AcceptTimeout = 3;
         static const int DataTimeout = 5;
         static const int BackLogSize = 100;
@@ -41,16 +72,33 @@ class SOAPThread
         const std::string m_host;
         const int m_port;
 
-        std::thread m_workerThread;
+        std::thread m_workerThread;                         // accepts connections and queues them for pool
+        std::vector<std::thread> m_poolThreads;             // serve queued connections
+
+        std::mutex m_queueLock;
+        std::condition_variable m_queueCondition;
+        std::deque<soap*> m_queue;
+        bool m_stopping;
+
+        SOAPCredentialCache m_credentials;
 
         void Work();
+        void ServeConnections();
 
     public:
         static const AccountTypes MinLevel = AccountTypes::SEC_ADMINISTRATOR;
         static const int CommandOutputBufferSize = 256;
+        static const int WorkerThreads = 5;
+        static const int CredentialCacheTime = 60;
 
-        SOAPThread(const std::string& host, int port);
+        SOAPThread(const std::string& host, int port, int workerThreads, uint32 credentialCacheTime);
         ~SOAPThread();
+
+        // checks login of the request, returns HTTP status code or SOAP_OK
+        int CheckLogin(soap* soap, uint32& accountId);
+
+        // runs command in world thread and waits for its end, returns false if command failed or server stops
+        static bool ExecuteCommand(uint32 accountId, const char* command, std::string& output);
 };
 
 #endif
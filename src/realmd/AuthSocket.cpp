@@ -27,6 +27,7 @@
 #include "Config/Config.h"
 #include "Log.h"
 #include "RealmList.h"
+#include "BanList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
 #include "SRP6/SRP6.h"
@@ -183,7 +184,7 @@ std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B,
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER)
+    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), _accountId(0), _failedLogins(0)
 {
 }
 
@@ -360,11 +361,7 @@ bool AuthSocket::_HandleLogonChallenge()
     pkt << (uint8) 0x00;
 
     ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
-    std::unique_ptr<QueryResult> ip_banned_result(LoginDatabase.PQuery("SELECT unbandate FROM ip_banned "
-            "WHERE (unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str()));
-
-    if (ip_banned_result)
+    if (sBanList.IsIpBanned(m_address))
     {
         pkt << (uint8)WOW_FAIL_FAIL_NOACCESS;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
@@ -373,7 +370,7 @@ bool AuthSocket::_HandleLogonChallenge()
     {
         ///- Get the account details from the account table
         // No SQL injection (escaped user name)
-        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,last_ip,gmlevel,v,s,token FROM account WHERE username = '%s'", _safelogin.c_str());
+        QueryResult* result = LoginDatabase.PQuery("SELECT id,locked,last_ip,gmlevel,v,s,token,failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
         if (result)
         {
             Field* fields = result->Fetch();
@@ -410,11 +407,10 @@ bool AuthSocket::_HandleLogonChallenge()
             if (!locked && !broken)
             {
                 ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT bandate,unbandate FROM account_banned WHERE "
-                                         "id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)", fields[0].GetUInt32());
-                if (banresult)
+                bool permanentBan;
+                if (sBanList.IsAccountBanned(fields[0].GetUInt32(), permanentBan))
                 {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
+                    if (permanentBan)
                     {
                         pkt << (uint8) WOW_FAIL_BANNED;
                         BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
@@ -424,8 +420,6 @@ bool AuthSocket::_HandleLogonChallenge()
                         pkt << (uint8) WOW_FAIL_SUSPENDED;
                         BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
                     }
-
-                    delete banresult;
                 }
                 else
                 {
@@ -450,6 +444,8 @@ bool AuthSocket::_HandleLogonChallenge()
                     uint8 securityFlags = 0;
 
                     _token = fields[6].GetCppString();
+                    _accountId = fields[0].GetUInt32();
+                    _failedLogins = fields[7].GetUInt32();
                     if (!_token.empty() && _build >= 8606) // authenticator was added in 2.4.3
                         securityFlags = SECURITY_FLAG_AUTHENTICATOR;
 
@@ -602,35 +598,33 @@ bool AuthSocket::_HandleLogonProof()
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
+            // count read at challenge, saves query of the just updated value
+            uint32 failed_logins = ++_failedLogins;
+
+            if (failed_logins >= MaxWrongPassCount)
             {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
+                uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+                bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+                time_t banDate = time(nullptr);
 
-                if (failed_logins >= MaxWrongPassCount)
+                if (WrongPassBanType)
                 {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
+                    LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                           _accountId, WrongPassBanTime);
+                    sBanList.AddAccountBan(_accountId, banDate, banDate + WrongPassBanTime);
+                    BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                              _login.c_str(), WrongPassBanTime, failed_logins);
+                }
+                else
+                {
+                    std::string current_ip = m_address;
+                    LoginDatabase.escape_string(current_ip);
+                    LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                           current_ip.c_str(), WrongPassBanTime);
+                    sBanList.AddIpBan(m_address, banDate, banDate + WrongPassBanTime);
+                    BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                              current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
                 }
-                delete loginfail;
             }
         }
     }
@@ -680,7 +674,7 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey, id FROM account WHERE username = '%s'", _safelogin.c_str());
 
     // Stop if the account is not found
     if (!result)
@@ -692,6 +686,7 @@ bool AuthSocket::_HandleReconnectChallenge()
 
     Field* fields = result->Fetch();
     srp.SetStrongSessionKey(fields[0].GetString());
+    _accountId = fields[1].GetUInt32();
     delete result;
 
     ///- All good, await client's proof
@@ -769,26 +764,10 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
-
-    QueryResult* result = LoginDatabase.PQuery("SELECT id FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!result)
-    {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
-        Close();
-        return false;
-    }
-
-    uint32 id = (*result)[0].GetUInt32();
-    delete result;
-
-    ///- Update realm list if need
-    sRealmList.UpdateIfNeed();
-
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
+    // account id is known since challenge, realm list is kept updated by main thread
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt, _accountId);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -799,8 +778,29 @@ bool AuthSocket::_HandleRealmList()
     return true;
 }
 
+void AuthSocket::LoadCharacterCounts(uint32 acctid, std::map<uint32, uint8>& counts) const
+{
+    // all realms at once instead of query per realm
+    QueryResult* result = LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", acctid);
+    if (!result)
+        return;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        counts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+    }
+    while (result->NextRow());
+    delete result;
+}
+
 void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
 {
+    std::shared_ptr<RealmList::RealmMap const> realms = sRealmList.GetRealms();
+
+    std::map<uint32, uint8> characterCounts;
+    LoadCharacterCounts(acctid, characterCounts);
+
     switch (_build)
     {
         case 5875:                                          // 1.12.1
@@ -808,22 +808,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
         case 6141:                                          // 1.12.3
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint8(sRealmList.size());
+            pkt << uint8(realms->size());
 
-            for (const auto& i : sRealmList)
+            for (const auto& i : *realms)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator count = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = count != characterCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
@@ -869,22 +859,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
         default:                                            // and later
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint16(sRealmList.size());
+            pkt << uint16(realms->size());
 
-            for (const auto& i : sRealmList)
+            for (const auto& i : *realms)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                std::map<uint32, uint8>::const_iterator count = characterCounts.find(i.second.m_ID);
+                uint8 AmountOfCharacters = count != characterCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
 
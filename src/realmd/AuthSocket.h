@@ -46,6 +46,7 @@ class AuthSocket : public MaNGOS::Socket
 
         void SendProof(Sha1Hash sha);
         void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        void LoadCharacterCounts(uint32 acctid, std::map<uint32, uint8>& counts) const;
         int32 generateToken(char const* b32key);
 
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
@@ -86,6 +87,8 @@ class AuthSocket : public MaNGOS::Socket
         std::string _localizationName;
         uint16 _build;
         AccountTypes _accountSecurityLevel;
+        uint32 _accountId;                                  // known after logon or reconnect challenge
+        uint32 _failedLogins;
 
         virtual bool ProcessIncomingData() override;
 };
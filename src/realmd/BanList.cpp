@@ -0,0 +1,127 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "BanList.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+extern DatabaseType LoginDatabase;
+
+BanList::BanList() : m_updateInterval(0), m_nextUpdateTime(0)
+{
+}
+
+BanList& BanList::Instance()
+{
+    static BanList banlist;
+    return banlist;
+}
+
+void BanList::Ban::Merge(time_t banDate, time_t banEndDate)
+{
+    // several bans of same ip or account, longest one counts
+    if (banDate == banEndDate)
+        permanent = true;
+    else if (banEndDate > unbanDate)
+        unbanDate = banEndDate;
+}
+
+void BanList::Initialize(uint32 updateInterval)
+{
+    m_updateInterval = std::max(updateInterval, 1u);
+
+    LoadBans();
+}
+
+void BanList::UpdateIfNeed()
+{
+    if (m_nextUpdateTime > time(nullptr))
+        return;
+
+    LoadBans();
+}
+
+void BanList::LoadBans()
+{
+    m_nextUpdateTime = time(nullptr) + m_updateInterval;
+
+    IpBanMap ipBans;
+    AccountBanMap accountBans;
+
+    if (QueryResult* result = LoginDatabase.Query("SELECT ip, bandate, unbandate FROM ip_banned WHERE unbandate = bandate OR unbandate > UNIX_TIMESTAMP()"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            ipBans[fields[0].GetCppString()].Merge(time_t(fields[1].GetUInt64()), time_t(fields[2].GetUInt64()));
+        }
+        while (result->NextRow());
+        delete result;
+    }
+
+    if (QueryResult* result = LoginDatabase.Query("SELECT id, bandate, unbandate FROM account_banned WHERE active = 1 AND (unbandate = bandate OR unbandate > UNIX_TIMESTAMP())"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            accountBans[fields[0].GetUInt32()].Merge(time_t(fields[1].GetUInt64()), time_t(fields[2].GetUInt64()));
+        }
+        while (result->NextRow());
+        delete result;
+    }
+
+    DETAIL_LOG("Loaded %u ip and %u account bans", uint32(ipBans.size()), uint32(accountBans.size()));
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_ipBans.swap(ipBans);
+    m_accountBans.swap(accountBans);
+}
+
+bool BanList::IsIpBanned(const std::string& ip) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    IpBanMap::const_iterator itr = m_ipBans.find(ip);
+    return itr != m_ipBans.end() && itr->second.IsActive(time(nullptr));
+}
+
+bool BanList::IsAccountBanned(uint32 accountId, bool& permanent) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    AccountBanMap::const_iterator itr = m_accountBans.find(accountId);
+    if (itr == m_accountBans.end() || !itr->second.IsActive(time(nullptr)))
+        return false;
+
+    permanent = itr->second.permanent;
+    return true;
+}
+
+void BanList::AddIpBan(const std::string& ip, time_t banDate, time_t unbanDate)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_ipBans[ip].Merge(banDate, unbanDate);
+}
+
+void BanList::AddAccountBan(uint32 accountId, time_t banDate, time_t unbanDate)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_accountBans[accountId].Merge(banDate, unbanDate);
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _BANLIST_H
+#define _BANLIST_H
+
+#include "Common.h"
+
+#include <mutex>
+#include <unordered_map>
+
+/// Active ip and account bans kept in memory, so login checks need no database query
+class BanList
+{
+    public:
+        static BanList& Instance();
+
+        BanList();
+
+        void Initialize(uint32 updateInterval);
+
+        /// Reload bans from database if update interval passed, called from realmd main thread
+        void UpdateIfNeed();
+
+        bool IsIpBanned(const std::string& ip) const;
+        /// permanent is set for bans without end date
+        bool IsAccountBanned(uint32 accountId, bool& permanent) const;
+
+        /// Bans added by realmd itself are known before next reload
+        void AddIpBan(const std::string& ip, time_t banDate, time_t unbanDate);
+        void AddAccountBan(uint32 accountId, time_t banDate, time_t unbanDate);
+
+    private:
+        struct Ban
+        {
+            Ban() : permanent(false), unbanDate(0) {}
+
+            bool permanent;
+            time_t unbanDate;
+
+            void Merge(time_t banDate, time_t banEndDate);
+            bool IsActive(time_t now) const { return permanent || unbanDate > now; }
+        };
+
+        typedef std::unordered_map<std::string, Ban> IpBanMap;
+        typedef std::unordered_map<uint32, Ban> AccountBanMap;
+
+        void LoadBans();
+
+        IpBanMap m_ipBans;
+        AccountBanMap m_accountBans;
+        mutable std::mutex m_lock;
+
+        uint32 m_updateInterval;
+        time_t m_nextUpdateTime;
+};
+
+#define sBanList BanList::Instance()
+
+#endif
+/// @}
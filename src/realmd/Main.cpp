@@ -23,6 +23,7 @@
 #include "Common.h"
 #include "Database/DatabaseEnv.h"
 #include "RealmList.h"
+#include "BanList.h"
 
 #include "Config/Config.h"
 #include "Log.h"
@@ -61,6 +62,7 @@ int m_ServiceStatus = -1;
 #endif
 
 bool StartDB();
+int GetNetworkThreadCount();
 void UnhookSignals();
 void HookSignals();
 
@@ -222,8 +224,11 @@ int main(int argc, char* argv[])
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE unbandate<=UNIX_TIMESTAMP() AND unbandate<>bandate");
     LoginDatabase.CommitTransaction();
 
-    // FIXME - more intelligent selection of thread count is needed here.  config option?
-    MaNGOS::Listener<AuthSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), sConfig.GetIntDefault("RealmServerPort", DEFAULT_REALMSERVER_PORT), 1);
+    ///- Load active bans, checked at every logon challenge
+    sBanList.Initialize(sConfig.GetIntDefault("BanListUpdateDelay", 10));
+
+    // handshake bignum math runs in network threads, so several of them serve reconnect storms in parallel
+    MaNGOS::Listener<AuthSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), sConfig.GetIntDefault("RealmServerPort", DEFAULT_REALMSERVER_PORT), GetNetworkThreadCount());
 
     ///- Catch termination signals
     HookSignals();
@@ -290,6 +295,11 @@ int main(int argc, char* argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+
+        // reloaded here so network thread never waits for them
+        sRealmList.UpdateIfNeed();
+        sBanList.UpdateIfNeed();
+
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
@@ -337,9 +347,11 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    // one query connection per network thread, so logon queries of different threads don't wait for each other
+    int nConnections = GetNetworkThreadCount();
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Cannot connect to database");
         return false;
@@ -355,6 +367,19 @@ bool StartDB()
     return true;
 }
 
+/// Number of threads serving auth sockets
+int GetNetworkThreadCount()
+{
+    int threads = sConfig.GetIntDefault("Network.Threads", 1);
+    if (threads <= 0)
+    {
+        sLog.outError("Invalid network thread workers setting in realmd.conf. (%d) should be > 0", threads);
+        threads = 1;
+    }
+
+    return threads;
+}
+
 /// Define hook 'OnSignal' for all termination signals
 void HookSignals()
 {
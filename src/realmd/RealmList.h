@@ -25,6 +25,8 @@
 
 #include "Common.h"
 #include <array>
+#include <memory>
+#include <mutex>
 
 struct RealmBuildInfo
 {
@@ -68,16 +70,18 @@ class RealmList
 
         void Initialize(uint32 updateInterval);
 
+        /// Reload realms if update delay passed, called from realmd main thread
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        /// Realm list valid at call time, stays unchanged while held by network thread
+        std::shared_ptr<RealmMap const> GetRealms() const;
+        uint32 size() const { return GetRealms()->size(); }
     private:
         void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
     private:
-        RealmMap m_realms;                                  ///< Internal map of realms
+        std::shared_ptr<RealmMap const> m_realms;           ///< Internal map of realms, replaced as whole at update
+        mutable std::mutex m_realmsLock;
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
 };
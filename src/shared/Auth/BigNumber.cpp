@@ -17,9 +17,21 @@
  */
 
 #include "Auth/BigNumber.h"
+#include "TSS.h"
 #include <openssl/bn.h>
 #include <algorithm>
 
+// scratch space of BN operations, kept per thread instead of allocated for every operation
+struct BigNumberContext
+{
+    BigNumberContext() : ctx(BN_CTX_new()) {}
+    ~BigNumberContext() { BN_CTX_free(ctx); }
+
+    BN_CTX* ctx;
+};
+
+static MaNGOS::thread_local_ptr<BigNumberContext> bnContext;
+
 BigNumber::BigNumber()
 {
     _bn = BN_new();
@@ -95,27 +107,21 @@ BigNumber BigNumber::operator-=(const BigNumber& bn)
 
 BigNumber BigNumber::operator*=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mul(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mul(_bn, _bn, bn._bn, bnContext->ctx);
 
     return *this;
 }
 
 BigNumber BigNumber::operator/=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_div(_bn, nullptr, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_div(_bn, nullptr, _bn, bn._bn, bnContext->ctx);
 
     return *this;
 }
 
 BigNumber BigNumber::operator%=(const BigNumber& bn)
 {
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mod(_bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod(_bn, _bn, bn._bn, bnContext->ctx);
 
     return *this;
 }
@@ -124,9 +130,7 @@ BigNumber BigNumber::Exp(const BigNumber& bn)
 {
     BigNumber ret;
 
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_exp(ret._bn, _bn, bn._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_exp(ret._bn, _bn, bn._bn, bnContext->ctx);
 
     return ret;
 }
@@ -135,9 +139,16 @@ BigNumber BigNumber::ModExp(const BigNumber& bn1, const BigNumber& bn2)
 {
     BigNumber ret;
 
-    BN_CTX* bnctx = BN_CTX_new();
-    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnctx);
-    BN_CTX_free(bnctx);
+    BN_mod_exp(ret._bn, _bn, bn1._bn, bn2._bn, bnContext->ctx);
+
+    return ret;
+}
+
+BigNumber BigNumber::ModExp(const BigNumber& bn1, const BigNumber& bn2, const MontgomeryContext& mont)
+{
+    BigNumber ret;
+
+    BN_mod_exp_mont(ret._bn, _bn, bn1._bn, bn2._bn, bnContext->ctx, mont._mont);
 
     return ret;
 }
@@ -184,3 +195,14 @@ const char* BigNumber::AsDecStr() const
 {
     return BN_bn2dec(_bn);
 }
+
+MontgomeryContext::MontgomeryContext(const BigNumber& modulus)
+{
+    _mont = BN_MONT_CTX_new();
+    BN_MONT_CTX_set(_mont, modulus._bn, bnContext->ctx);
+}
+
+MontgomeryContext::~MontgomeryContext()
+{
+    BN_MONT_CTX_free(_mont);
+}
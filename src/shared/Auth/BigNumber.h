@@ -22,6 +22,9 @@
 #include "Common.h"
 
 struct bignum_st;
+struct bn_mont_ctx_st;
+
+class MontgomeryContext;
 
 class BigNumber
 {
@@ -74,6 +77,8 @@ class BigNumber
         bool isZero() const;
 
         BigNumber ModExp(const BigNumber& bn1, const BigNumber& bn2);
+        // same as above with precomputed data of modulus bn2
+        BigNumber ModExp(const BigNumber& bn1, const BigNumber& bn2, const MontgomeryContext& mont);
         BigNumber Exp(const BigNumber&);
 
         int GetNumBytes(void) const;
@@ -87,7 +92,26 @@ class BigNumber
         const char* AsDecStr() const;
 
     private:
+        friend class MontgomeryContext;
+
         struct bignum_st* _bn;
         uint8* _array;
 };
+
+// Montgomery form of an odd modulus, computed once for modulus used in many ModExp calls
+// read only after creation, can be shared by threads
+class MontgomeryContext
+{
+    public:
+        explicit MontgomeryContext(const BigNumber& modulus);
+        ~MontgomeryContext();
+
+        MontgomeryContext(const MontgomeryContext&) = delete;
+        MontgomeryContext& operator=(const MontgomeryContext&) = delete;
+
+    private:
+        friend class BigNumber;
+
+        struct bn_mont_ctx_st* _mont;
+};
 #endif
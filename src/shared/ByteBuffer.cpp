@@ -19,6 +19,175 @@
 #include "ByteBuffer.h"
 #include "Log.h"
 
+#include <mutex>
+#include <new>
+
+namespace
+{
+    enum
+    {
+        MIN_BLOCK_SHIFT = 6,                                // 64 bytes, most small packets fit in it
+        SIZE_CLASSES = 9,                                   // up to 16KB, larger are taken from heap directly
+        MAX_THREAD_CLASS_BYTES = 256 * 1024,
+        MAX_SHARED_CLASS_BYTES = 4 * MAX_THREAD_CLASS_BYTES
+    };
+
+    struct Block
+    {
+        Block* next;
+    };
+
+    inline size_t GetSizeClass(size_t size)
+    {
+        size_t sizeClass = 0;
+        while ((size_t(1) << (MIN_BLOCK_SHIFT + sizeClass)) < size)
+            ++sizeClass;
+        return sizeClass;
+    }
+
+    inline size_t GetClassSize(size_t sizeClass) { return size_t(1) << (MIN_BLOCK_SHIFT + sizeClass); }
+
+    inline uint32 GetMaxThreadBlocks(size_t sizeClass) { return MAX_THREAD_CLASS_BYTES / GetClassSize(sizeClass); }
+
+    // detach up to count blocks from list head, returns detached chain
+    Block* TakeBlocks(Block*& head, uint32& headCount, uint32 count, uint32& taken)
+    {
+        Block* chain = head;
+        Block* last = nullptr;
+        taken = 0;
+        while (head && taken < count)
+        {
+            last = head;
+            head = head->next;
+            ++taken;
+        }
+        if (last)
+            last->next = nullptr;
+        headCount -= taken;
+        return taken ? chain : nullptr;
+    }
+
+    // blocks exceeding thread free lists, taken by threads with empty lists
+    struct SharedFreeLists
+    {
+        SharedFreeLists() : heads(), counts() {}
+
+        void Put(size_t sizeClass, Block* chain)
+        {
+            std::lock_guard<std::mutex> guard(locks[sizeClass]);
+            while (chain && counts[sizeClass] < MAX_SHARED_CLASS_BYTES / GetClassSize(sizeClass))
+            {
+                Block* block = chain;
+                chain = chain->next;
+                block->next = heads[sizeClass];
+                heads[sizeClass] = block;
+                ++counts[sizeClass];
+            }
+
+            // full, rest go back to heap
+            while (Block* block = chain)
+            {
+                chain = block->next;
+                ::operator delete(block);
+            }
+        }
+
+        Block* Take(size_t sizeClass, uint32 count, uint32& taken)
+        {
+            std::lock_guard<std::mutex> guard(locks[sizeClass]);
+            return TakeBlocks(heads[sizeClass], counts[sizeClass], count, taken);
+        }
+
+        std::mutex locks[SIZE_CLASSES];
+        Block* heads[SIZE_CLASSES];
+        uint32 counts[SIZE_CLASSES];
+    };
+
+    // never destroyed, thread free lists are handed over to it at thread exit, also used by static buffers construction
+    SharedFreeLists& GetSharedFreeLists()
+    {
+        static SharedFreeLists* lists = new SharedFreeLists;
+        return *lists;
+    }
+
+    struct ThreadFreeLists
+    {
+        ThreadFreeLists() : heads(), counts(), released(false) {}
+        ~ThreadFreeLists()
+        {
+            for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES; ++sizeClass)
+            {
+                if (heads[sizeClass])
+                    GetSharedFreeLists().Put(sizeClass, heads[sizeClass]);
+                heads[sizeClass] = nullptr;
+                counts[sizeClass] = 0;
+            }
+            released = true;                                // buffers used at thread exit later go directly to heap
+        }
+
+        Block* heads[SIZE_CLASSES];
+        uint32 counts[SIZE_CLASSES];
+        bool released;
+    };
+
+    thread_local ThreadFreeLists threadFreeLists;
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    size_t sizeClass = GetSizeClass(size);
+    if (sizeClass >= SIZE_CLASSES)
+        return ::operator new(size);
+
+    ThreadFreeLists& lists = threadFreeLists;
+    if (lists.released)
+        return ::operator new(GetClassSize(sizeClass));
+
+    if (!lists.heads[sizeClass])
+    {
+        // refill half of thread list at once to take shared lock rarely
+        uint32 taken;
+        lists.heads[sizeClass] = GetSharedFreeLists().Take(sizeClass, GetMaxThreadBlocks(sizeClass) / 2, taken);
+        lists.counts[sizeClass] = taken;
+    }
+
+    if (Block* block = lists.heads[sizeClass])
+    {
+        lists.heads[sizeClass] = block->next;
+        --lists.counts[sizeClass];
+        return block;
+    }
+
+    return ::operator new(GetClassSize(sizeClass));
+}
+
+void PacketBufferPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    size_t sizeClass = GetSizeClass(size);
+    ThreadFreeLists& lists = threadFreeLists;
+    if (sizeClass >= SIZE_CLASSES || lists.released)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // full, hand over half to other threads
+    if (lists.counts[sizeClass] >= GetMaxThreadBlocks(sizeClass))
+    {
+        uint32 taken;
+        Block* chain = TakeBlocks(lists.heads[sizeClass], lists.counts[sizeClass], GetMaxThreadBlocks(sizeClass) / 2, taken);
+        GetSharedFreeLists().Put(sizeClass, chain);
+    }
+
+    Block* block = static_cast<Block*>(ptr);
+    block->next = lists.heads[sizeClass];
+    lists.heads[sizeClass] = block;
+    ++lists.counts[sizeClass];
+}
+
 void ByteBufferException::PrintPosError() const
 {
     sLog.outError("Attempted to %s in ByteBuffer (pos: " SIZEFMTD " size: " SIZEFMTD ") value with size: " SIZEFMTD,
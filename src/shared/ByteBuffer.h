@@ -45,6 +45,29 @@ struct Unused
     Unused() {}
 };
 
+// packet storage memory by power of two size class, freed blocks are kept in thread free lists
+// and handed over between threads, so packets built in map threads and sent by network threads are reused
+namespace PacketBufferPool
+{
+    void* Allocate(size_t size);
+    void Deallocate(void* ptr, size_t size);
+}
+
+template<class T>
+struct PacketBufferAllocator
+{
+    typedef T value_type;
+
+    PacketBufferAllocator() {}
+    template<class U> PacketBufferAllocator(PacketBufferAllocator<U> const&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(PacketBufferPool::Allocate(n * sizeof(T))); }
+    void deallocate(T* ptr, size_t n) { PacketBufferPool::Deallocate(ptr, n * sizeof(T)); }
+
+    template<class U> bool operator==(PacketBufferAllocator<U> const&) const { return true; }
+    template<class U> bool operator!=(PacketBufferAllocator<U> const&) const { return false; }
+};
+
 class ByteBuffer
 {
     public:
@@ -418,7 +441,7 @@ class ByteBuffer
 
     protected:
         size_t _rpos, _wpos;
-        std::vector<uint8> _storage;
+        std::vector<uint8, PacketBufferAllocator<uint8> > _storage;
 };
 
 template <typename T>
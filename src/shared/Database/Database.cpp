@@ -91,6 +91,13 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+void SqlConnection::FormatStmt(int nIndex, const SqlStmtParameters& id, std::string& sql)
+{
+    // statement object of connection keeps the format, no registry lookup per batched request
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    SqlPlainPreparedStatement::FormatRequest(pStmt->format(), id, m_db, sql);
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
@@ -164,7 +171,7 @@ void Database::StopServer()
 SqlDelayThread* Database::CreateDelayThread()
 {
     assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    return new SqlDelayThread(this, m_pAsyncConn, m_pQueryConnections);
 }
 
 void Database::InitDelayThread()
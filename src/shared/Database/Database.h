@@ -61,8 +61,16 @@ class SqlConnection
         // can't rollback without transaction support
         virtual bool RollbackTransaction() { return true; }
 
+        // several ';' separated statements per request, only between BeginBatch and EndBatch
+        // nothing do if DB not support it, statements are executed one by one then
+        virtual bool BeginBatch() { return false; }
+        virtual void EndBatch() {}
+        virtual bool ExecuteBatch(const char* /*sql*/) { return false; }
+
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        // append statement with bound parameters as plain SQL
+        void FormatStmt(int nIndex, const SqlStmtParameters& id, std::string& sql);
 
         // SqlConnection object lock
         class Lock
@@ -133,7 +133,7 @@ bool MySQLConnection::Initialize(const char* infoString)
 #endif
 
     mMysql = mysql_real_connect(mysqlInit, host.c_str(), user.c_str(),
-                                password.c_str(), database.c_str(), port, unix_socket, 0);
+                                password.c_str(), database.c_str(), port, unix_socket, CLIENT_MULTI_RESULTS);
 
     if (!mMysql)
     {
@@ -288,6 +288,44 @@ bool MySQLConnection::RollbackTransaction()
     return _TransactionCmd("ROLLBACK");
 }
 
+bool MySQLConnection::BeginBatch()
+{
+    // multi statements are only allowed while a batch is sent, so single requests can't be stacked
+    return mMysql && !mysql_set_server_option(mMysql, MYSQL_OPTION_MULTI_STATEMENTS_ON);
+}
+
+void MySQLConnection::EndBatch()
+{
+    mysql_set_server_option(mMysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+}
+
+bool MySQLConnection::ExecuteBatch(const char* sql)
+{
+    uint32 _s = WorldTimer::getMSTime();
+
+    // server stops at first failed statement, results of the executed ones must be read anyway
+    uint32 nDone = 0;
+    int status = mysql_query(mMysql, sql);
+    while (!status)
+    {
+        if (MYSQL_RES* result = mysql_store_result(mMysql))
+            mysql_free_result(result);
+
+        ++nDone;
+        status = mysql_next_result(mMysql);
+    }
+
+    if (status > 0)
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("SQL ERROR in statement %u of batch: %s", nDone + 1, mysql_error(mMysql));
+        return false;
+    }
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    return true;
+}
+
 unsigned long MySQLConnection::escape_string(char* to, const char* from, unsigned long length)
 {
     if (!mMysql || !to || !from || !length)
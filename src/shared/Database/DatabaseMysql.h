@@ -83,6 +83,10 @@ class MySQLConnection : public SqlConnection
         bool CommitTransaction() override;
         bool RollbackTransaction() override;
 
+        bool BeginBatch() override;
+        void EndBatch() override;
+        bool ExecuteBatch(const char* sql) override;
+
     protected:
         SqlPreparedStatement* CreateStatement(const std::string& fmt) override;
 
@@ -20,7 +20,9 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, std::vector<SqlConnection*> const& holderConnections) :
+    m_dbEngine(db), m_dbConnection(conn), m_running(true), m_holderConnections(holderConnections),
+    m_holder(nullptr), m_holderNextIndex(0), m_holderGeneration(0), m_holderBusyWorkers(0), m_holderStopping(false)
 {
 }
 
@@ -40,6 +42,8 @@ void SqlDelayThread::run()
 
     const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
 
+    StartHolderWorkers();
+
     uint32 loopCounter = 0;
     while (m_running)
     {
@@ -56,6 +60,9 @@ void SqlDelayThread::run()
         }
     }
 
+    // requests left in queue are processed by destructor without workers
+    StopHolderWorkers();
+
 #ifndef DO_POSTGRESQL
     mysql_thread_end();
 #endif
@@ -84,3 +91,82 @@ void SqlDelayThread::ProcessRequests()
         s->Execute(m_dbConnection);
     }
 }
+
+void SqlDelayThread::StartHolderWorkers()
+{
+    m_holderStopping = false;
+    for (SqlConnection* conn : m_holderConnections)
+        m_holderWorkers.emplace_back(&SqlDelayThread::HolderWorker, this, conn);
+}
+
+void SqlDelayThread::StopHolderWorkers()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_holderMutex);
+        m_holderStopping = true;
+    }
+    m_holderCondition.notify_all();
+
+    for (std::thread& worker : m_holderWorkers)
+        worker.join();
+
+    m_holderWorkers.clear();
+}
+
+void SqlDelayThread::HolderWorker(SqlConnection* conn)
+{
+    m_dbEngine->ThreadStart();
+
+    uint32 generation = 0;
+    std::unique_lock<std::mutex> lock(m_holderMutex);
+    while (true)
+    {
+        m_holderCondition.wait(lock, [&] { return m_holderStopping || m_holderGeneration != generation; });
+        if (m_holderStopping)
+            break;
+
+        generation = m_holderGeneration;
+
+        // woken too late, the delay thread did all queries itself already
+        SqlQueryHolder* holder = m_holder;
+        if (!holder)
+            continue;
+
+        ++m_holderBusyWorkers;
+        lock.unlock();
+
+        holder->ExecuteQueries(conn, m_holderNextIndex);
+
+        lock.lock();
+        if (--m_holderBusyWorkers == 0)
+            m_holderDoneCondition.notify_one();
+    }
+    lock.unlock();
+
+    m_dbEngine->ThreadEnd();
+}
+
+void SqlDelayThread::ExecuteHolder(SqlQueryHolder* holder, SqlConnection* conn)
+{
+    if (m_holderWorkers.empty())
+    {
+        std::atomic<size_t> nextIndex(0);
+        holder->ExecuteQueries(conn, nextIndex);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_holderMutex);
+        m_holder = holder;
+        m_holderNextIndex = 0;
+        ++m_holderGeneration;
+    }
+    m_holderCondition.notify_all();
+
+    // the delay thread takes its share on its own connection
+    holder->ExecuteQueries(conn, m_holderNextIndex);
+
+    std::unique_lock<std::mutex> lock(m_holderMutex);
+    m_holderDoneCondition.wait(lock, [&] { return m_holderBusyWorkers == 0; });
+    m_holder = nullptr;
+}
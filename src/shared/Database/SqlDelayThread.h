@@ -23,12 +23,17 @@
 #include "SqlOperations.h"
 
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <queue>
+#include <vector>
 #include <memory>
 
 class Database;
 class SqlOperation;
 class SqlConnection;
+class SqlQueryHolder;
 
 class SqlDelayThread : public MaNGOS::Runnable
 {
@@ -39,13 +44,32 @@ class SqlDelayThread : public MaNGOS::Runnable
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
         volatile bool m_running;
 
+        // query holders are executed in parallel on the sync query connections
+        std::vector<SqlConnection*> m_holderConnections;
+        std::vector<std::thread> m_holderWorkers;
+        std::mutex m_holderMutex;
+        std::condition_variable m_holderCondition;      ///< signals workers a new holder or stop
+        std::condition_variable m_holderDoneCondition;  ///< signals delay thread the last busy worker is done
+        SqlQueryHolder* m_holder;                       ///< holder in execution, guarded by m_holderMutex
+        std::atomic<size_t> m_holderNextIndex;
+        uint32 m_holderGeneration;
+        uint32 m_holderBusyWorkers;
+        bool m_holderStopping;
+
         // process all enqueued requests
         void ProcessRequests();
 
+        void StartHolderWorkers();
+        void StopHolderWorkers();
+        void HolderWorker(SqlConnection* conn);
+
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, std::vector<SqlConnection*> const& holderConnections = std::vector<SqlConnection*>());
         ~SqlDelayThread();
 
+        // executes all queries of the holder, returns when all results are set
+        void ExecuteHolder(SqlQueryHolder* holder, SqlConnection* conn);
+
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
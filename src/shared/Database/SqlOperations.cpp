@@ -25,6 +25,9 @@
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
+// batch is sent when it grows past this size, keep well below server's max_allowed_packet
+#define MAX_TRANSACTION_BATCH_LEN (512*1024)
+
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
 
 bool SqlPlainRequest::Execute(SqlConnection* conn)
@@ -34,6 +37,12 @@ bool SqlPlainRequest::Execute(SqlConnection* conn)
     return conn->Execute(m_sql);
 }
 
+bool SqlPlainRequest::AppendToBatch(SqlConnection* /*conn*/, std::string& batch)
+{
+    batch.append(";").append(m_sql);
+    return true;
+}
+
 SqlTransaction::~SqlTransaction()
 {
     while (!m_queue.empty())
@@ -50,6 +59,14 @@ bool SqlTransaction::Execute(SqlConnection* conn)
 
     LOCK_DB_CONN(conn);
 
+    // send all statements in a few round trips instead of one per statement
+    if (m_queue.size() > 1 && conn->BeginBatch())
+    {
+        bool const res = ExecuteBatched(conn);
+        conn->EndBatch();
+        return res;
+    }
+
     conn->BeginTransaction();
 
     const int nItems = m_queue.size();
@@ -67,6 +84,49 @@ bool SqlTransaction::Execute(SqlConnection* conn)
     return conn->CommitTransaction();
 }
 
+// send collected statements, separator in front of a batch started in the middle of transaction is skipped
+static bool FlushBatch(SqlConnection* conn, std::string& batch)
+{
+    if (batch.empty())
+        return true;
+
+    bool const res = conn->ExecuteBatch(batch.c_str() + (batch[0] == ';' ? 1 : 0));
+    batch.clear();
+    return res;
+}
+
+bool SqlTransaction::ExecuteBatched(SqlConnection* conn)
+{
+    std::string batch = "START TRANSACTION";
+
+    const int nItems = m_queue.size();
+    for (int i = 0; i < nItems; ++i)
+    {
+        SqlOperation* pStmt = m_queue[i];
+
+        bool res;
+        if (pStmt->AppendToBatch(conn, batch))
+            res = batch.size() < MAX_TRANSACTION_BATCH_LEN || FlushBatch(conn, batch);
+        else                                                // transaction stays open between batches
+            res = FlushBatch(conn, batch) && pStmt->Execute(conn);
+
+        if (!res)
+        {
+            conn->RollbackTransaction();
+            return false;
+        }
+    }
+
+    batch.append(";COMMIT");
+    if (!FlushBatch(conn, batch))
+    {
+        conn->RollbackTransaction();
+        return false;
+    }
+
+    return true;
+}
+
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters* arg) : m_nIndex(nIndex), m_param(arg)
 {
 }
@@ -82,6 +142,16 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+bool SqlPreparedRequest::AppendToBatch(SqlConnection* conn, std::string& batch)
+{
+    if (m_nIndex == -1)
+        return false;
+
+    batch.append(";");
+    conn->FormatStmt(m_nIndex, *m_param, batch);
+    return true;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection* conn)
@@ -124,7 +194,7 @@ bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* t
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, thread);
     thread->Delay(holderEx);
     return true;
 }
@@ -209,6 +279,20 @@ SqlQueryHolder::~SqlQueryHolder()
     }
 }
 
+void SqlQueryHolder::ExecuteQueries(SqlConnection* conn, std::atomic<size_t>& nextIndex)
+{
+    for (size_t i = nextIndex++; i < m_queries.size(); i = nextIndex++)
+    {
+        /// execute the queries of the holder and pass the results, every index is taken by one thread only
+        char const* sql = m_queries[i].first;
+        if (!sql)
+            continue;
+
+        LOCK_DB_CONN(conn);
+        SetResult(i, conn->Query(sql));
+    }
+}
+
 void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
@@ -220,15 +304,9 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     if (!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
-    /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
-    for (size_t i = 0; i < queries.size(); ++i)
-    {
-        /// execute all queries in the holder and pass the results
-        char const* sql = queries[i].first;
-        if (sql) m_holder->SetResult(i, conn->Query(sql));
-    }
+    /// the queries are spread over the holder workers of the delay thread,
+    /// it returns when all are done so later queued requests still see the results as before
+    m_thread->ExecuteHolder(m_holder, conn);
 
     /// sync with the caller thread
     m_queue->Add(m_callback);
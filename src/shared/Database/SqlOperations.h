@@ -26,6 +26,7 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <atomic>
 
 /// ---- BASE ---
 
@@ -39,6 +40,8 @@ class SqlOperation
     public:
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection* conn) = 0;
+        // add request as plain SQL to a multi-statement batch, false if it can only be executed on its own
+        virtual bool AppendToBatch(SqlConnection* /*conn*/, std::string& /*batch*/) { return false; }
         virtual ~SqlOperation() {}
 };
 
@@ -52,6 +55,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete[] tofree; }
         bool Execute(SqlConnection* conn) override;
+        bool AppendToBatch(SqlConnection* conn, std::string& batch) override;
 };
 
 class SqlTransaction : public SqlOperation
@@ -66,6 +70,9 @@ class SqlTransaction : public SqlOperation
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
 
         bool Execute(SqlConnection* conn) override;
+
+    private:
+        bool ExecuteBatched(SqlConnection* conn);
 };
 
 class SqlPreparedRequest : public SqlOperation
@@ -75,6 +82,7 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection* conn) override;
+        bool AppendToBatch(SqlConnection* conn, std::string& batch) override;
 
     private:
         const int m_nIndex;
@@ -119,9 +127,13 @@ class SqlQuery : public SqlOperation
 class SqlQueryHolder
 {
         friend class SqlQueryHolderEx;
+        friend class SqlDelayThread;
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+
+        // executes queries until all indexes are taken, can be called from several threads at once
+        void ExecuteQueries(SqlConnection* conn, std::atomic<size_t>& nextIndex);
     public:
         SqlQueryHolder() {}
         ~SqlQueryHolder();
@@ -139,9 +151,10 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        SqlDelayThread* m_thread;
     public:
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, SqlDelayThread* thread)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_thread(thread) {}
         bool Execute(SqlConnection* conn) override;
 };
 #endif                                                      //__SQLOPERATIONS_H
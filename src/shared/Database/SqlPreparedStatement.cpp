@@ -18,6 +18,9 @@
 
 #include "DatabaseEnv.h"
 
+#include <iomanip>
+#include <limits>
+
 SqlStmtParameters::SqlStmtParameters(uint32 nParams)
 {
     // reserve memory if needed
@@ -101,7 +104,12 @@ void SqlPlainPreparedStatement::bind(const SqlStmtParameters& holder)
     }
 
     // reset resulting plain SQL request
-    m_szPlainRequest = m_szFmt;
+    m_szPlainRequest.clear();
+    FormatRequest(m_szFmt, holder, m_pConn.DB(), m_szPlainRequest);
+}
+
+void SqlPlainPreparedStatement::FormatRequest(const std::string& fmt, const SqlStmtParameters& holder, Database& db, std::string& request)
+{
     size_t nLastPos = 0;
 
     SqlStmtParameters::ParameterContainer const& _args = holder.params();
@@ -109,20 +117,19 @@ void SqlPlainPreparedStatement::bind(const SqlStmtParameters& holder)
     SqlStmtParameters::ParameterContainer::const_iterator iter_last = _args.end();
     for (SqlStmtParameters::ParameterContainer::const_iterator iter = _args.begin(); iter != iter_last; ++iter)
     {
-        // bind parameter
-        const SqlStmtFieldData& data = (*iter);
+        size_t nPos = fmt.find('?', nLastPos);
+        if (nPos == std::string::npos)
+            break;
 
-        std::ostringstream fmt;
-        DataToString(data, fmt);
+        // bind parameter
+        std::ostringstream data;
+        DataToString(*iter, db, data);
 
-        nLastPos = m_szPlainRequest.find('?', nLastPos);
-        if (nLastPos != std::string::npos)
-        {
-            std::string tmp = fmt.str();
-            m_szPlainRequest.replace(nLastPos, 1, tmp);
-            nLastPos += tmp.length();
-        }
+        request.append(fmt, nLastPos, nPos - nLastPos).append(data.str());
+        nLastPos = nPos + 1;
     }
+
+    request.append(fmt, nLastPos, std::string::npos);
 }
 
 bool SqlPlainPreparedStatement::execute()
@@ -133,7 +140,7 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
-void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const
+void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, Database& db, std::ostringstream& fmt)
 {
     switch (data.type())
     {
@@ -146,12 +153,12 @@ void SqlPlainPreparedStatement::DataToString(const SqlStmtFieldData& data, std::
         case FIELD_I16:     fmt << "'" << int32(data.toInt16()) << "'";     break;
         case FIELD_I32:     fmt << "'" << data.toInt32() << "'";            break;
         case FIELD_I64:     fmt << "'" << data.toInt64() << "'";            break;
-        case FIELD_FLOAT:   fmt << "'" << data.toFloat() << "'";            break;
-        case FIELD_DOUBLE:  fmt << "'" << data.toDouble() << "'";           break;
+        case FIELD_FLOAT:   fmt << "'" << std::setprecision(std::numeric_limits<float>::max_digits10) << data.toFloat() << "'";   break;
+        case FIELD_DOUBLE:  fmt << "'" << std::setprecision(std::numeric_limits<double>::max_digits10) << data.toDouble() << "'"; break;
         case FIELD_STRING:
         {
             std::string tmp = data.toStr();
-            m_pConn.DB().escape_string(tmp);
+            db.escape_string(tmp);
             fmt << "'" << tmp << "'";
             break;
         }
@@ -306,6 +306,8 @@ class SqlPreparedStatement
         uint32 params() const { return m_nParams; }
         uint32 columns() const { return isQuery() ? m_nColumns : 0; }
 
+        const std::string& format() const { return m_szFmt; }
+
         // initialize internal structures of prepared statement
         // upon success m_bPrepared should be true
         virtual bool prepare() = 0;
@@ -344,8 +346,11 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
 
         virtual bool execute() override;
 
+        // append fmt with '?' replaced by bound parameters to request
+        static void FormatRequest(const std::string& fmt, const SqlStmtParameters& holder, Database& db, std::string& request);
+
     protected:
-        void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
+        static void DataToString(const SqlStmtFieldData& data, Database& db, std::ostringstream& fmt);
 
         std::string m_szPlainRequest;
 };
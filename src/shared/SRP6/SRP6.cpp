@@ -21,16 +21,39 @@
 #include "Auth/base32.h"
 #include "SRP6.h"
 
-SRP6::SRP6()
+#include <memory>
+
+namespace
+{
+    // prime and generator are same for every session, so Montgomery form of N is computed only once
+    struct SRP6Constants
+    {
+        SRP6Constants()
+        {
+            N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+            g.SetDword(7);
+            montN.reset(new MontgomeryContext(N));
+        }
+
+        BigNumber N, g;
+        std::unique_ptr<MontgomeryContext> montN;
+    };
+
+    SRP6Constants const& GetConstants()
+    {
+        static SRP6Constants const constants;
+        return constants;
+    }
+}
+
+SRP6::SRP6() : N(GetConstants().N), g(GetConstants().g)
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
 }
 
 void SRP6::CalculateHostPublicEphemeral(void)
 {
     b.SetRand(19 * 8);
-    BigNumber gmod = g.ModExp(b, N);
+    BigNumber gmod = g.ModExp(b, N, *GetConstants().montN);
     B = ((v * 3) + gmod) % N;
 
     MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
@@ -84,7 +107,7 @@ bool SRP6::CalculateSessionKey(uint8* lp_A, int l)
     sha.UpdateBigNumbers(&A, &B, nullptr);
     sha.Finalize();
     u.SetBinary(sha.GetDigest(), 20);
-    S = (A * (v.ModExp(u, N))).ModExp(b, N);
+    S = (A * (v.ModExp(u, N, *GetConstants().montN))).ModExp(b, N, *GetConstants().montN);
 
     return true;
 }
@@ -121,7 +144,7 @@ bool SRP6::CalculateVerifier(const std::string& rI, const char* salt)
     sha.Finalize();
     BigNumber x;
     x.SetBinary(sha.GetDigest(), Sha1Hash::GetLength());
-    v = g.ModExp(x, N);
+    v = g.ModExp(x, N, *GetConstants().montN);
 
     return true;
 }
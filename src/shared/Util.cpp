@@ -35,6 +35,18 @@ std::mt19937* initRand()
 
 static MaNGOS::thread_local_ptr<std::mt19937> mtRand(&initRand);
 
+ScopedRandomSeed::ScopedRandomSeed(uint32 seed) : m_previous(mtRand.get())
+{
+    mtRand.release();
+    mtRand.reset(new std::mt19937(seed));
+}
+
+ScopedRandomSeed::~ScopedRandomSeed()
+{
+    // deletes the seeded generator
+    mtRand.reset(m_previous);
+}
+
 uint32 WorldTimer::m_iTime = 0;
 uint32 WorldTimer::m_iPrevTime = 0;
 
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <vector>
+#include <random>
 
 typedef std::vector<std::string> Tokens;
 
@@ -42,6 +43,20 @@ inline uint32 secsToTimeBitFields(time_t secs)
     return (lt->tm_year - 100) << 24 | lt->tm_mon  << 20 | (lt->tm_mday - 1) << 14 | lt->tm_wday << 11 | lt->tm_hour << 6 | lt->tm_min;
 }
 
+/* Random functions of the current thread return the sequence of the seed while this is alive, e.g. to repeat rolls later */
+class ScopedRandomSeed
+{
+    public:
+        explicit ScopedRandomSeed(uint32 seed);
+        ~ScopedRandomSeed();
+
+        ScopedRandomSeed(ScopedRandomSeed const&) = delete;
+        ScopedRandomSeed& operator=(ScopedRandomSeed const&) = delete;
+
+    private:
+        std::mt19937* m_previous;
+};
+
 /* Return a random number in the range min..max; (max-min) must be smaller than 32768. */
 int32 irand(int32 min, int32 max);
 